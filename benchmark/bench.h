@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+  using edge_t = std::pair<std::size_t, std::size_t>;
+
+  /***
+   * Return the i-th command line argument parsed as an unsigned integer,
+   * or the given fallback value if the argument is missing.
+   */
+  inline std::size_t arg_or(int argc, char** argv, int i, std::size_t fallback) {
+    return i < argc ? std::strtoull(argv[i], nullptr, 10) : fallback;
+  }
+
+  /***
+   * Run f once and return the elapsed wall-clock time in seconds.
+   */
+  template <typename F>
+  double time_it(F&& f) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  // print a single measurement, normalized by the number of processed items
+  inline void report(const std::string& name, double seconds, std::size_t items) {
+    std::cout << name << ": " << seconds << " s, " << (seconds * 1e9 / double(items))
+              << " ns/item, " << (double(items) / seconds / 1e6) << " Mitems/s\n";
+  }
+
+  // generate m edges whose endpoints are uniformly distributed in [0, n)
+  inline std::vector<edge_t> random_edges(std::size_t n, std::size_t m, std::uint64_t seed = 42) {
+    std::mt19937_64 rng{seed};
+    std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+    std::vector<edge_t> edges;
+    edges.reserve(m);
+
+    for (std::size_t k = 0; k < m; ++k) {
+      edges.emplace_back(dist(rng), dist(rng));
+    }
+
+    return edges;
+  }
+
+  // generate m edges whose endpoints follow a Zipf-like (power-law) distribution over [0, n)
+  inline std::vector<edge_t> power_law_edges(std::size_t n, std::size_t m,
+                                             std::uint64_t seed = 42) {
+    std::mt19937_64 rng{seed};
+    // x = n^u - 1 with u uniform in [0, 1) approximates a 1/x degree distribution
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    const auto log_n = std::log(double(n));
+    auto draw = [&]() {
+      const auto x = static_cast<std::size_t>(std::exp(dist(rng) * log_n)) - 1;
+      return x < n ? x : n - 1;
+    };
+
+    std::vector<edge_t> edges;
+    edges.reserve(m);
+
+    for (std::size_t k = 0; k < m; ++k) {
+      edges.emplace_back(draw(), draw());
+    }
+
+    return edges;
+  }
+
+}  // namespace bench
@@ -0,0 +1,79 @@
+// Random find and are_connected queries on a DenseDisjointSet whose nodes don't fit in the
+// cache: loops over find and are_connected, against the software-pipelined find_batch and
+// are_connected_batch. Every measurement starts from a copy of the same disjoint set.
+// Usage: batch_find_benchmark [elements = 50000000] [queries = 20000000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 50'000'000);
+  const auto q = bench::arg_or(argc, argv, 2, 20'000'000);
+  std::cout << "elements: " << n << ", queries: " << q << '\n';
+
+  // half as many unions as elements leave long uncompressed paths
+  DenseDisjointSet base{n};
+  for (auto&& [u, v] : bench::random_edges(n, n / 2)) {
+    base.unite(u, v);
+  }
+
+  std::mt19937_64 rng{7};
+  std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+  std::vector<std::size_t> ids(q);
+  std::vector<std::pair<std::size_t, std::size_t>> pairs(q);
+  for (std::size_t k = 0; k < q; ++k) {
+    ids[k] = dist(rng);
+    pairs[k] = {dist(rng), dist(rng)};
+  }
+
+  std::vector<std::size_t> roots(q);
+  std::vector<char> connected(q);
+  std::size_t checksum = 0;
+
+  {
+    auto ds = base;
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t k = 0; k < q; ++k) {
+        roots[k] = ds.find(ids[k]);
+      }
+    });
+    bench::report("loop over find", seconds, q);
+    checksum += roots[q / 2];
+  }
+
+  {
+    auto ds = base;
+    const auto seconds = bench::time_it([&]() {
+      ds.find_batch(ids, roots.begin());
+    });
+    bench::report("find_batch", seconds, q);
+    checksum -= roots[q / 2];
+  }
+
+  {
+    auto ds = base;
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t k = 0; k < q; ++k) {
+        connected[k] = ds.are_connected(pairs[k].first, pairs[k].second);
+      }
+    });
+    bench::report("loop over are_connected", seconds, q);
+  }
+
+  {
+    auto ds = base;
+    const auto seconds = bench::time_it([&]() {
+      ds.are_connected_batch(pairs, connected.begin());
+    });
+    bench::report("are_connected_batch", seconds, q);
+  }
+
+  std::cout << "checksum (0 if the results match): " << checksum << '\n';
+}
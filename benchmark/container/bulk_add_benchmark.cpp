@@ -0,0 +1,89 @@
+// Ingest throughput of new elements, streamed in batches between which a few pairs are
+// united: one add at a time, versus reserve plus add_range, for both DisjointSet<uint64_t>
+// and DenseDisjointSet.
+// Usage: bulk_add_benchmark [elements = 20000000] [batches = 20]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 20'000'000);
+  const auto batches = bench::arg_or(argc, argv, 2, 20);
+  const auto batch = n / batches;
+  std::cout << "elements: " << n << ", batches: " << batches << '\n';
+
+  std::mt19937_64 rng{42};
+  std::vector<std::uint64_t> keys(batch * batches);
+  for (auto& key : keys) {
+    key = rng();
+  }
+
+  // unite a few elements of the last batch, as a stream of pairs would
+  auto unite_some = [&](auto& ds, auto key_of, std::size_t last) {
+    for (auto i = last - batch; i + 1 < last; i += 64) {
+      ds.unite(key_of(i), key_of(i + 1));
+    }
+  };
+  auto key_of = [&](std::size_t i) {
+    return keys[i];
+  };
+  auto id_of = [](std::size_t i) {
+    return i;
+  };
+
+  const auto add_seconds = bench::time_it([&]() {
+    DisjointSet<std::uint64_t> ds{{}};
+    for (std::size_t b = 0; b < batches; ++b) {
+      for (auto i = b * batch; i < (b + 1) * batch; ++i) {
+        ds.add(keys[i]);
+      }
+      unite_some(ds, key_of, (b + 1) * batch);
+    }
+  });
+  bench::report("DisjointSet: add", add_seconds, keys.size());
+
+  const auto add_range_seconds = bench::time_it([&]() {
+    DisjointSet<std::uint64_t> ds{{}};
+    ds.reserve(keys.size());
+    for (std::size_t b = 0; b < batches; ++b) {
+      ds.add_range(keys.begin() + b * batch, keys.begin() + (b + 1) * batch);
+      unite_some(ds, key_of, (b + 1) * batch);
+    }
+  });
+  bench::report("DisjointSet: reserve + add_range", add_range_seconds, keys.size());
+
+  const auto dense_add_seconds = bench::time_it([&]() {
+    DenseDisjointSet ds{0};
+    for (std::size_t b = 0; b < batches; ++b) {
+      for (std::size_t i = 0; i < batch; ++i) {
+        ds.add();
+      }
+      unite_some(ds, id_of, (b + 1) * batch);
+    }
+  });
+  bench::report("DenseDisjointSet: add", dense_add_seconds, keys.size());
+
+  for (std::size_t num_threads : {std::size_t(1), jkds::util::default_num_threads()}) {
+    const auto dense_range_seconds = bench::time_it([&]() {
+      DenseDisjointSet ds{0};
+      ds.reserve(keys.size());
+      for (std::size_t b = 0; b < batches; ++b) {
+        ds.add_range(batch, num_threads);
+        unite_some(ds, id_of, (b + 1) * batch);
+      }
+    });
+    bench::report("DenseDisjointSet: reserve + add_range, " + std::to_string(num_threads) +
+                      " threads",
+                  dense_range_seconds, keys.size());
+  }
+}
@@ -0,0 +1,247 @@
+// The operations of a character class compiler on random sets of bytes: ByteSet is compared
+// with SparseByteSet and std::bitset<256>, where SparseByteSet emulates the set algebra,
+// ordered iteration and rank/select one member at a time, as a caller would have to.
+// Every operation is run over pairs of sets of about the given number of members.
+// Usage: byte_set_benchmark [pairs = 4096] [members per set = 32] [rounds = 100]
+
+#include <bench.h>
+#include <jkds/container/byte_set.h>
+#include <jkds/container/sparse_byte_set.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jkds::container;
+
+namespace {
+
+  // run f(i) for every pair i, in every round, and report the time per pair
+  template <typename F>
+  void run(const std::string& name, std::size_t pairs, std::size_t rounds, F f) {
+    std::size_t checksum = 0;
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t r = 0; r < rounds; ++r) {
+        for (std::size_t i = 0; i < pairs; ++i) {
+          checksum += f(i);
+        }
+      }
+    });
+    bench::report(name, seconds, pairs * rounds);
+    std::cout << "  checksum: " << checksum << '\n';
+  }
+
+  template <typename F>
+  void for_each_bit(const std::bitset<256>& bits, F f) {
+#if defined(__GLIBCXX__)
+    // libstdc++ skips the empty words
+    for (auto b = bits._Find_first(); b < 256; b = bits._Find_next(b)) {
+      f(b);
+    }
+#else
+    for (std::size_t b = 0; b < 256; ++b) {
+      if (bits.test(b)) {
+        f(b);
+      }
+    }
+#endif
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto pairs = bench::arg_or(argc, argv, 1, 4096);
+  const auto members = bench::arg_or(argc, argv, 2, 32);
+  const auto rounds = bench::arg_or(argc, argv, 3, 100);
+  std::cout << "pairs: " << pairs << ", members: " << members << ", rounds: " << rounds << '\n';
+
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::vector<std::uint8_t> bytes(2 * pairs * members);
+  for (auto& b : bytes) {
+    b = static_cast<std::uint8_t>(byte(rng));
+  }
+
+  std::vector<ByteSet> sets(2 * pairs);
+  std::vector<SparseByteSet> sparse_sets(2 * pairs);
+  std::vector<std::bitset<256>> bitsets(2 * pairs);
+  for (std::size_t i = 0; i < 2 * pairs; ++i) {
+    for (std::size_t k = 0; k < members; ++k) {
+      const auto b = bytes[i * members + k];
+      sets[i].add(b);
+      sparse_sets[i].add(b);
+      bitsets[i].set(b);
+    }
+  }
+
+  std::cout << "# build\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    ByteSet set;
+    for (std::size_t k = 0; k < members; ++k) {
+      set.add(bytes[i * members + k]);
+    }
+    return set.size();
+  });
+  run("SparseByteSet", pairs, rounds, [&](std::size_t i) {
+    SparseByteSet set;
+    for (std::size_t k = 0; k < members; ++k) {
+      set.add(bytes[i * members + k]);
+    }
+    return set.size();
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    std::bitset<256> set;
+    for (std::size_t k = 0; k < members; ++k) {
+      set.set(bytes[i * members + k]);
+    }
+    return set.count();
+  });
+
+  std::cout << "# contains, of the members of the other set\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    std::size_t found = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      found += sets[2 * i].contains(bytes[(2 * i + 1) * members + k]);
+    }
+    return found;
+  });
+  run("SparseByteSet", pairs, rounds, [&](std::size_t i) {
+    std::size_t found = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      found += sparse_sets[2 * i].contains(bytes[(2 * i + 1) * members + k]);
+    }
+    return found;
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    std::size_t found = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      found += bitsets[2 * i].test(bytes[(2 * i + 1) * members + k]);
+    }
+    return found;
+  });
+
+  std::cout << "# union, intersection and size\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    const auto& a = sets[2 * i];
+    const auto& b = sets[2 * i + 1];
+    return (a | b).size() + (a & b).size();
+  });
+  run("SparseByteSet", pairs, rounds, [&](std::size_t i) {
+    const auto& a = sparse_sets[2 * i];
+    const auto& b = sparse_sets[2 * i + 1];
+    SparseByteSet both;
+    SparseByteSet common;
+    for (auto x : a) {
+      both.add(x);
+      if (b.contains(x)) {
+        common.add(x);
+      }
+    }
+    for (auto x : b) {
+      both.add(x);
+    }
+    return both.size() + common.size();
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    const auto& a = bitsets[2 * i];
+    const auto& b = bitsets[2 * i + 1];
+    return (a | b).count() + (a & b).count();
+  });
+
+  std::cout << "# complement\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    return (~sets[i]).size();
+  });
+  run("SparseByteSet", pairs, rounds, [&](std::size_t i) {
+    SparseByteSet complement;
+    for (unsigned b = 0; b < 256; ++b) {
+      if (!sparse_sets[i].contains(static_cast<std::uint8_t>(b))) {
+        complement.add(static_cast<std::uint8_t>(b));
+      }
+    }
+    return complement.size();
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    return (~bitsets[i]).count();
+  });
+
+  std::cout << "# ordered iteration\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    std::size_t sum = 0;
+    std::size_t position = 0;
+    for (auto b : sets[i]) {
+      sum += b * ++position;
+    }
+    return sum;
+  });
+  run("SparseByteSet (sorted copy)", pairs, rounds, [&](std::size_t i) {
+    std::vector<std::uint8_t> sorted(sparse_sets[i].begin(), sparse_sets[i].end());
+    std::sort(sorted.begin(), sorted.end());
+    std::size_t sum = 0;
+    std::size_t position = 0;
+    for (auto b : sorted) {
+      sum += b * ++position;
+    }
+    return sum;
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    std::size_t sum = 0;
+    std::size_t position = 0;
+    for_each_bit(bitsets[i], [&](std::size_t b) {
+      sum += b * ++position;
+    });
+    return sum;
+  });
+
+  std::cout << "# rank and select, of the members of the other set\n";
+  run("ByteSet", pairs, rounds, [&](std::size_t i) {
+    const auto& set = sets[2 * i];
+    const auto size = set.size();
+    std::size_t sum = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      const auto rank = set.rank(bytes[(2 * i + 1) * members + k]);
+      sum += rank + (rank < size ? set.select(rank) : 0);
+    }
+    return sum;
+  });
+  run("SparseByteSet", pairs, rounds, [&](std::size_t i) {
+    const auto& set = sparse_sets[2 * i];
+    std::size_t sum = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      const auto byte = bytes[(2 * i + 1) * members + k];
+      std::size_t rank = 0;
+      unsigned next = 256;
+      for (auto x : set) {
+        rank += x < byte;
+        if (x >= byte && x < next) {
+          next = x;
+        }
+      }
+      sum += rank + (next < 256 ? next : 0);
+    }
+    return sum;
+  });
+  run("std::bitset<256>", pairs, rounds, [&](std::size_t i) {
+    const auto& set = bitsets[2 * i];
+    const auto size = set.count();
+    std::size_t sum = 0;
+    for (std::size_t k = 0; k < members; ++k) {
+      const auto byte = bytes[(2 * i + 1) * members + k];
+      const auto rank = (set << (256 - byte)).count() * (byte != 0);
+      std::size_t selected = 0;
+      if (rank < size) {
+        std::size_t seen = 0;
+        for_each_bit(set, [&](std::size_t b) {
+          if (seen++ == rank) {
+            selected = b;
+          }
+        });
+      }
+      sum += rank + selected;
+    }
+    return sum;
+  });
+}
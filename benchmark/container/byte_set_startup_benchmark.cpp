@@ -0,0 +1,128 @@
+// The startup cost of the character classes of a tokenizer: building them at runtime, as
+// SparseByteSet (one add per byte), ByteSet or compiled ByteClass, versus declaring them
+// constexpr, in which case they're emitted as constant data and there's nothing to run.
+// The first runtime build is timed on its own, since it's the one a short-lived process pays,
+// and then the average over many rounds.
+// Usage: byte_set_startup_benchmark [rounds = 100000]
+
+#include <bench.h>
+#include <jkds/container/byte_set.h>
+#include <jkds/container/sparse_byte_set.h>
+#include <jkds/util/byte_scan.h>
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace jkds::container;
+using jkds::util::ByteClass;
+
+namespace {
+
+  constexpr std::size_t num_classes = 8;
+
+  // the classes of a small tokenizer, with the ranges spelled out as a runtime build would
+  const std::vector<std::string> specs{
+      " \t\r\n\v\f",
+      "0123456789",
+      "0123456789abcdefABCDEF",
+      "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ",
+      "_abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789",
+      "\t\n ,;",
+      "+-*/%=<>!&|^~",
+      "\"'`",
+  };
+
+  constexpr auto identifier_start = make_byte_set("_") | byte_range('a', 'z') |
+                                    byte_range('A', 'Z');
+
+  // the same classes, built at compile time
+  constexpr std::array<ByteSet, num_classes> constexpr_sets{
+      make_byte_set(" \t\r\n\v\f"),
+      byte_range('0', '9'),
+      byte_range('0', '9') | byte_range('a', 'f') | byte_range('A', 'F'),
+      identifier_start,
+      identifier_start | byte_range('0', '9'),
+      make_byte_set("\t\n ,;"),
+      make_byte_set("+-*/%=<>!&|^~"),
+      make_byte_set("\"'`"),
+  };
+
+  constexpr std::array<ByteClass, num_classes> constexpr_classes{
+      ByteClass{constexpr_sets[0]}, ByteClass{constexpr_sets[1]}, ByteClass{constexpr_sets[2]},
+      ByteClass{constexpr_sets[3]}, ByteClass{constexpr_sets[4]}, ByteClass{constexpr_sets[5]},
+      ByteClass{constexpr_sets[6]}, ByteClass{constexpr_sets[7]},
+  };
+
+  std::size_t build_sparse_byte_sets() {
+    std::size_t checksum = 0;
+    for (const auto& spec : specs) {
+      SparseByteSet set;
+      for (auto c : spec) {
+        set.add(static_cast<std::uint8_t>(c));
+      }
+      checksum += set.size();
+    }
+    return checksum;
+  }
+
+  std::size_t build_byte_sets() {
+    std::size_t checksum = 0;
+    for (const auto& spec : specs) {
+      checksum += ByteSet{spec}.size();
+    }
+    return checksum;
+  }
+
+  std::size_t build_byte_classes() {
+    std::size_t checksum = 0;
+    for (const auto& spec : specs) {
+      checksum += ByteClass{spec}.size();
+    }
+    return checksum;
+  }
+
+  std::size_t read_constexpr_classes() {
+    std::size_t checksum = 0;
+    for (const auto& byte_class : constexpr_classes) {
+      checksum += byte_class.size();
+    }
+    return checksum;
+  }
+
+  template <typename F>
+  void run(const std::string& name, std::size_t rounds, F build) {
+    std::size_t checksum = 0;
+    const auto first = bench::time_it([&]() {
+      checksum += build();
+    });
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t r = 0; r < rounds; ++r) {
+        checksum += build();
+      }
+    });
+    std::cout << name << ": first " << first * 1e9 << " ns, then "
+              << seconds * 1e9 / double(rounds) << " ns per tokenizer (checksum " << checksum
+              << ")\n";
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto rounds = bench::arg_or(argc, argv, 1, 100'000);
+  std::cout << "classes per tokenizer: " << num_classes << ", rounds: " << rounds << '\n';
+
+  // the constexpr tables are checked against the runtime ones, and are never built
+  for (std::size_t k = 0; k < num_classes; ++k) {
+    if (constexpr_sets[k] != ByteSet{specs[k]}) {
+      std::cerr << "mismatch in class " << k << '\n';
+      return 1;
+    }
+  }
+
+  run("constexpr ByteClass (read only)", rounds, read_constexpr_classes);
+  run("runtime SparseByteSet", rounds, build_sparse_byte_sets);
+  run("runtime ByteSet", rounds, build_byte_sets);
+  run("runtime ByteClass", rounds, build_byte_classes);
+}
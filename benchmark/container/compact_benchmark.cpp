@@ -0,0 +1,102 @@
+// Locality of a DenseDisjointSet before and after compact: the elements are assigned to
+// random clusters, so that the members of every set are scattered across the nodes. Then
+// every path is compressed, and the same find workloads run before and after compact.
+// Usage: compact_benchmark [elements = 20000000] [clusters = 100000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jkds::container;
+
+namespace {
+
+  // run the find workloads, returning a checksum of the representatives
+  std::size_t run_finds(DenseDisjointSet& ds, const std::vector<std::size_t>& queries,
+                        const std::string& label) {
+    const auto n = ds.size();
+    std::size_t checksum = 0;
+
+    const auto sequential_seconds = bench::time_it([&]() {
+      for (std::size_t i = 0; i < n; ++i) {
+        checksum += ds.find(i);
+      }
+    });
+    bench::report(label + ": find over every element in order", sequential_seconds, n);
+
+    const auto random_seconds = bench::time_it([&]() {
+      for (auto i : queries) {
+        checksum += ds.find(i);
+      }
+    });
+    bench::report(label + ": find over random elements", random_seconds, queries.size());
+
+    // visit the sets one after the other, finding every member
+    std::size_t visited = 0;
+    const auto per_set_seconds = bench::time_it([&]() {
+      for (std::size_t i = 0; i < n; ++i) {
+        if (ds.find(i) == i) {
+          for (auto member : ds.members_of(i)) {
+            checksum += ds.find(member);
+            ++visited;
+          }
+        }
+      }
+    });
+    bench::report(label + ": find over the members of every set", per_set_seconds, visited);
+
+    return checksum;
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 20'000'000);
+  const auto k = bench::arg_or(argc, argv, 2, 100'000);
+  std::cout << "elements: " << n << ", clusters: " << k << '\n';
+
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<std::size_t> cluster{0, k - 1};
+  std::uniform_int_distribution<std::size_t> element{0, n - 1};
+
+  // the first element of every cluster, in the order of their creation
+  DenseDisjointSet ds{n};
+  std::vector<std::size_t> first(k, n);
+  for (std::size_t i = 0; i < n; ++i) {
+    auto& c = first[cluster(rng)];
+    if (c == n) {
+      c = i;
+    } else {
+      ds.unite(c, i);
+    }
+  }
+
+  std::vector<std::size_t> queries(n);
+  for (auto& query : queries) {
+    query = element(rng);
+  }
+
+  // compress every path, so that only the locality differs
+  for (std::size_t i = 0; i < n; ++i) {
+    (void) ds.find(i);
+  }
+
+  run_finds(ds, queries, "before compact");
+
+  std::vector<std::size_t> permutation;
+  const auto compact_seconds = bench::time_it([&]() {
+    permutation = ds.compact();
+  });
+  bench::report("compact", compact_seconds, n);
+
+  // the random queries refer to the same elements, renumbered
+  for (auto& query : queries) {
+    query = permutation[query];
+  }
+
+  run_finds(ds, queries, "after compact");
+}
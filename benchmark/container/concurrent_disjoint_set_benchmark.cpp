@@ -0,0 +1,54 @@
+// Thread scaling of ConcurrentDisjointSet::unite on random and power-law edge lists,
+// compared against a single-threaded DenseDisjointSet.
+// Usage: concurrent_disjoint_set_benchmark [vertices = 10000000] [edges = 100000000]
+//                                          [max threads = 64]
+
+#include <bench.h>
+#include <jkds/container/concurrent_disjoint_set.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <iostream>
+#include <string>
+
+using namespace jkds::container;
+
+namespace {
+
+  void run(const std::string& name, std::size_t n, const std::vector<bench::edge_t>& edges,
+           std::size_t max_threads) {
+    const auto m = edges.size();
+    std::cout << "== " << name << " ==\n";
+
+    const auto dense_seconds = bench::time_it([&]() {
+      DenseDisjointSet ds{n};
+      for (auto&& [u, v] : edges) {
+        ds.unite(u, v);
+      }
+    });
+    bench::report("DenseDisjointSet, 1 thread", dense_seconds, m);
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+      ConcurrentDisjointSet ds{n};
+      const auto seconds = bench::time_it([&]() {
+        jkds::util::parallel_for(0, m, [&](std::size_t first, std::size_t last) {
+          for (auto k = first; k < last; ++k) {
+            ds.unite(edges[k].first, edges[k].second);
+          }
+        }, threads);
+      });
+      bench::report("ConcurrentDisjointSet, " + std::to_string(threads) + " threads", seconds, m);
+    }
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 100'000'000);
+  const auto max_threads = bench::arg_or(argc, argv, 3, 64);
+  std::cout << "vertices: " << n << ", edges: " << m << '\n';
+
+  run("random", n, bench::random_edges(n, m), max_threads);
+  run("power-law", n, bench::power_law_edges(n, m), max_threads);
+}
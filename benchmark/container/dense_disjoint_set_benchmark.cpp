@@ -0,0 +1,49 @@
+// Connected components over a random graph: DisjointSet<std::size_t> vs DenseDisjointSet.
+// Usage: dense_disjoint_set_benchmark [vertices = 10000000] [edges = 100000000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+
+#include <iostream>
+#include <optional>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 100'000'000);
+  const auto edges = bench::random_edges(n, m);
+  std::cout << "vertices: " << n << ", edges: " << m << '\n';
+
+  // both sets are built outside of the timed unions, and their construction is reported on its
+  // own, per element
+  std::optional<DisjointSet<std::size_t>> keyed;
+  bench::report("DisjointSet<std::size_t> construction", bench::time_it([&]() {
+                  keyed.emplace(jkds::util::range<std::size_t>(n));
+                }),
+                n);
+  const auto keyed_seconds = bench::time_it([&]() {
+    for (auto&& [u, v] : edges) {
+      keyed->unite(u, v);
+    }
+  });
+  bench::report("DisjointSet<std::size_t>", keyed_seconds, m);
+  const auto keyed_components = keyed->get_sets().size();
+
+  std::optional<DenseDisjointSet> dense;
+  bench::report("DenseDisjointSet construction", bench::time_it([&]() {
+                  dense.emplace(n);
+                }),
+                n);
+  std::size_t dense_components = n;
+  const auto dense_seconds = bench::time_it([&]() {
+    for (auto&& [u, v] : edges) {
+      dense_components -= dense->unite(u, v);
+    }
+  });
+  bench::report("DenseDisjointSet", dense_seconds, m);
+
+  std::cout << "components: " << keyed_components << " / " << dense_components << '\n';
+  return keyed_components == dense_components ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+// Time to get a queryable DisjointSet<uint64_t> back after a restart: rebuilding it from the
+// pairs that created it, loading it from a saved file, or mapping the saved file with and
+// without checksum verification. Then the same random queries run on the loaded and the
+// mapped disjoint sets.
+// Usage: disjoint_set_file_benchmark [elements = 5000000] [pairs = 4000000]
+
+#include <bench.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/container/mapped_disjoint_set.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 5'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 4'000'000);
+  std::cout << "elements: " << n << ", pairs: " << m << '\n';
+
+  // sparse 64-bit keys
+  std::mt19937_64 rng{42};
+  std::vector<std::uint64_t> keys(n);
+  for (auto& key : keys) {
+    key = rng();
+  }
+  std::uniform_int_distribution<std::size_t> element{0, n - 1};
+  std::vector<std::pair<std::size_t, std::size_t>> pairs(m);
+  for (auto& [i, j] : pairs) {
+    i = element(rng);
+    j = element(rng);
+  }
+
+  const auto path = std::filesystem::temp_directory_path() / "jkds_disjoint_set_benchmark";
+  std::size_t checksum = 0;
+
+  const auto rebuild_seconds = bench::time_it([&]() {
+    DisjointSet<std::uint64_t> ds{keys};
+    for (auto [i, j] : pairs) {
+      ds.unite(keys[i], keys[j]);
+    }
+    checksum += ds.num_sets();
+    ds.save(path);
+  });
+  bench::report("rebuild from pairs (and save)", rebuild_seconds, n);
+  std::cout << "file size: " << std::filesystem::file_size(path) / (1 << 20) << " MiB\n";
+
+  std::vector<std::uint64_t> queries(1'000'000);
+  for (auto& query : queries) {
+    query = keys[element(rng)];
+  }
+
+  {
+    std::optional<DisjointSet<std::uint64_t>> loaded;
+    const auto load_seconds = bench::time_it([&]() {
+      loaded.emplace(DisjointSet<std::uint64_t>::load(path));
+    });
+    bench::report("load", load_seconds, n);
+
+    const auto query_seconds = bench::time_it([&]() {
+      for (std::size_t k = 1; k < queries.size(); ++k) {
+        checksum += loaded->are_connected(queries[k - 1], queries[k]);
+      }
+    });
+    bench::report("loaded are_connected", query_seconds, queries.size());
+  }
+
+#if JKDS_HAS_MMAP
+  for (bool verify : {true, false}) {
+    std::optional<MappedDisjointSet<std::uint64_t>> mapped;
+    const auto open_seconds = bench::time_it([&]() {
+      mapped.emplace(path, verify);
+    });
+    bench::report(verify ? "mapped open (verified)" : "mapped open (unverified)", open_seconds,
+                  n);
+
+    const auto query_seconds = bench::time_it([&]() {
+      for (std::size_t k = 1; k < queries.size(); ++k) {
+        checksum += mapped->are_connected(queries[k - 1], queries[k]);
+      }
+    });
+    bench::report("mapped are_connected", query_seconds, queries.size());
+  }
+#endif
+
+  std::filesystem::remove(path);
+  std::cout << "checksum: " << checksum << '\n';
+}
@@ -0,0 +1,72 @@
+// Snapshot of the sets of a disjoint set: get_sets() against get_partition().
+// Usage: partition_benchmark [elements = 10000000] [sets = 1000000]
+//                            [threads = hardware concurrency]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+
+#include <iostream>
+#include <random>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto k = bench::arg_or(argc, argv, 2, 1'000'000);
+  const auto threads = bench::arg_or(argc, argv, 3, jkds::util::default_num_threads());
+  std::cout << "elements: " << n << ", sets: " << k << ", threads: " << threads << '\n';
+
+  // assign every element to one of k random sets
+  DenseDisjointSet dense{n};
+  DisjointSet<std::size_t> keyed{jkds::util::range<std::size_t>(n)};
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<std::size_t> dist{0, k - 1};
+  for (std::size_t i = k; i < n; ++i) {
+    const auto set = dist(rng);
+    dense.unite(set, i);
+    keyed.unite(set, i);
+  }
+
+  // every measurement starts from the same, uncompressed, forest
+  {
+    auto ds = keyed;
+    std::size_t groups = 0;
+    const auto seconds = bench::time_it([&]() {
+      groups = ds.get_sets().size();
+    });
+    bench::report("DisjointSet::get_sets", seconds, n);
+    std::cout << "groups: " << groups << '\n';
+  }
+
+  {
+    auto ds = keyed;
+    std::size_t groups = 0;
+    const auto seconds = bench::time_it([&]() {
+      groups = ds.get_partition().size();
+    });
+    bench::report("DisjointSet::get_partition", seconds, n);
+    std::cout << "groups: " << groups << '\n';
+  }
+
+  {
+    auto ds = dense;
+    std::size_t groups = 0;
+    const auto seconds = bench::time_it([&]() {
+      groups = ds.get_sets().size();
+    });
+    bench::report("DenseDisjointSet::get_sets", seconds, n);
+    std::cout << "groups: " << groups << '\n';
+  }
+
+  for (std::size_t t = 1; t <= threads; t *= 2) {
+    auto ds = dense;
+    std::size_t groups = 0;
+    const auto seconds = bench::time_it([&]() {
+      groups = ds.get_partition(t).size();
+    });
+    bench::report("DenseDisjointSet::get_partition, " + std::to_string(t) + " threads", seconds,
+                  n);
+    std::cout << "groups: " << groups << '\n';
+  }
+}
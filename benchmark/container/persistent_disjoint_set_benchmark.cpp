@@ -0,0 +1,61 @@
+// Memory per version and query latency of PersistentDisjointSet, against DenseDisjointSet.
+// Usage: persistent_disjoint_set_benchmark [elements = 1000000] [versions = 1000000]
+//                                          [queries = 1000000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/persistent_disjoint_set.h>
+
+#include <iostream>
+#include <random>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 1'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 1'000'000);
+  const auto q = bench::arg_or(argc, argv, 3, 1'000'000);
+  std::cout << "elements: " << n << ", versions: " << m << ", queries: " << q << '\n';
+  const auto edges = bench::random_edges(n, m);
+
+  PersistentDisjointSet persistent{n};
+  const auto initial_nodes = persistent.num_nodes();
+  const auto unite_seconds = bench::time_it([&]() {
+    std::size_t version = 0;
+    for (auto&& [u, v] : edges) {
+      version = persistent.unite(version, u, v);
+    }
+  });
+  bench::report("PersistentDisjointSet::unite", unite_seconds, m);
+
+  const auto bytes_per_version =
+      double(persistent.num_nodes() - initial_nodes) * 2 * sizeof(std::size_t) / double(m);
+  std::cout << "initial version: " << initial_nodes * 2 * sizeof(std::size_t) << " bytes, "
+            << "every other version: " << bytes_per_version << " bytes\n";
+
+  // queries against random versions
+  std::mt19937_64 rng{7};
+  std::uniform_int_distribution<std::size_t> version_dist{0, m};
+  std::uniform_int_distribution<std::size_t> element_dist{0, n - 1};
+  std::size_t connected = 0;
+  const auto query_seconds = bench::time_it([&]() {
+    for (std::size_t k = 0; k < q; ++k) {
+      connected += persistent.are_connected(version_dist(rng), element_dist(rng),
+                                            element_dist(rng));
+    }
+  });
+  bench::report("PersistentDisjointSet::are_connected, random versions", query_seconds, q);
+
+  // the same number of queries against the latest version of an ephemeral disjoint set
+  DenseDisjointSet dense{n};
+  for (auto&& [u, v] : edges) {
+    dense.unite(u, v);
+  }
+  const auto dense_seconds = bench::time_it([&]() {
+    for (std::size_t k = 0; k < q; ++k) {
+      connected += dense.are_connected(element_dist(rng), element_dist(rng));
+    }
+  });
+  bench::report("DenseDisjointSet::are_connected, latest version", dense_seconds, q);
+  std::cout << "connected: " << connected << '\n';
+}
@@ -0,0 +1,81 @@
+// Multi-threaded query throughput of a read-mostly DenseDisjointSet, built from random
+// unions: are_connected behind a mutex, versus the lock-free are_connected_readonly, before
+// and after freeze. Every thread runs the same number of queries.
+// Usage: readonly_find_benchmark [elements = 10000000] [queries per thread = 5000000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto q = bench::arg_or(argc, argv, 2, 5'000'000);
+  std::cout << "elements: " << n << ", queries per thread: " << q
+            << ", hardware threads: " << jkds::util::default_num_threads() << '\n';
+
+  DenseDisjointSet ds{n};
+  for (auto [u, v] : bench::random_edges(n, n / 2)) {
+    ds.unite(u, v);
+  }
+  const auto queries = bench::random_edges(n, q, 7);
+
+  // run the queries on num_threads threads, returning the number of connected pairs
+  auto run = [&](std::size_t num_threads, const std::string& label, auto query) {
+    std::vector<std::size_t> connected(num_threads, 0);
+    const auto seconds = bench::time_it([&]() {
+      jkds::util::parallel_invoke(num_threads, [&](std::size_t t) {
+        std::size_t local = 0;
+        for (auto [u, v] : queries) {
+          local += query(u, v);
+        }
+        connected[t] = local;
+      });
+    });
+    bench::report(label + ", " + std::to_string(num_threads) + " threads", seconds,
+                  q * num_threads);
+    return connected[0];
+  };
+
+  for (std::size_t num_threads : {1, 2, 4}) {
+    std::mutex mutex;
+    run(num_threads, "are_connected with a mutex", [&](std::size_t u, std::size_t v) {
+      const std::lock_guard lock{mutex};
+      return ds.are_connected(u, v);
+    });
+  }
+
+  // a fresh copy, whose paths were only compressed by unite
+  DenseDisjointSet unfrozen{n};
+  for (auto [u, v] : bench::random_edges(n, n / 2)) {
+    unfrozen.unite(u, v);
+  }
+  const auto& view = unfrozen;
+  for (std::size_t num_threads : {1, 2, 4}) {
+    run(num_threads, "are_connected_readonly", [&](std::size_t u, std::size_t v) {
+      return view.are_connected_readonly(u, v);
+    });
+  }
+
+  const auto freeze_seconds = bench::time_it([&]() {
+    unfrozen.freeze();
+  });
+  bench::report("freeze", freeze_seconds, n);
+
+  std::size_t connected = 0;
+  for (std::size_t num_threads : {1, 2, 4}) {
+    connected = run(num_threads, "are_connected_readonly after freeze",
+                    [&](std::size_t u, std::size_t v) {
+                      return view.are_connected_readonly(u, v);
+                    });
+  }
+  std::cout << "connected pairs: " << connected << '\n';
+}
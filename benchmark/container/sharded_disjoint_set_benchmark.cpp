@@ -0,0 +1,75 @@
+// Deduplication of random pairs of 64-bit keys, split into disjoint streams, one per thread:
+// a single DisjointSet<std::uint64_t> protected by a std::mutex, against a ShardedDisjointSet
+// where every thread unites into its own shard, followed by the final merge.
+// Usage: sharded_disjoint_set_benchmark [keys = 4000000] [pairs = 8000000]
+//                                       [threads = hardware concurrency]
+
+#include <bench.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/container/sharded_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 4'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 8'000'000);
+  const auto threads = bench::arg_or(argc, argv, 3, jkds::util::default_num_threads());
+  std::cout << "keys: " << n << ", pairs: " << m << ", threads: " << threads << '\n';
+
+  // scatter the vertices of a random graph over the 64-bit keys
+  std::mt19937_64 rng{42};
+  std::vector<std::uint64_t> keys(n);
+  for (auto& key : keys) {
+    key = rng();
+  }
+
+  const auto edges = bench::random_edges(n, m);
+  std::vector<std::vector<std::pair<std::uint64_t, std::uint64_t>>> streams(threads);
+  for (std::size_t k = 0; k < m; ++k) {
+    streams[k % threads].emplace_back(keys[edges[k].first], keys[edges[k].second]);
+  }
+
+  DisjointSet<std::uint64_t> locked{{}};
+  std::mutex mutex;
+  const auto locked_seconds = bench::time_it([&]() {
+    jkds::util::parallel_invoke(threads, [&](std::size_t t) {
+      for (auto&& [x, y] : streams[t]) {
+        std::lock_guard lock{mutex};
+        if (!locked.contains(x)) {
+          locked.add(x);
+        }
+        if (!locked.contains(y)) {
+          locked.add(y);
+        }
+        locked.unite(x, y);
+      }
+    });
+  });
+  bench::report("DisjointSet<std::uint64_t> behind a std::mutex", locked_seconds, m);
+
+  ShardedDisjointSet<std::uint64_t> sharded{threads};
+  const auto unite_seconds = bench::time_it([&]() {
+    jkds::util::parallel_invoke(threads, [&](std::size_t t) {
+      auto& shard = sharded.shard(t);
+      for (auto&& [x, y] : streams[t]) {
+        shard.unite(x, y);
+      }
+    });
+  });
+  const auto merge_seconds = bench::time_it([&]() {
+    sharded.merge(threads);
+  });
+  bench::report("ShardedDisjointSet: shards", unite_seconds, m);
+  bench::report("ShardedDisjointSet: merge", merge_seconds, m);
+  bench::report("ShardedDisjointSet: total", unite_seconds + merge_seconds, m);
+
+  std::cout << "sets: " << locked.num_sets() << " / " << sharded.num_sets() << '\n';
+}
@@ -0,0 +1,220 @@
+// Entity-to-component storage: n particles with random entity ids in a universe of u ids are
+// inserted, updated in place by many passes over every value (the iteration-heavy part),
+// looked up by id, and half of them are erased and inserted again.
+// SparseMap is compared with std::unordered_map and with a minimal open-addressing map
+// (linear probing over flat key/value slots, at most half full), standing in for
+// absl::flat_hash_map, which isn't a dependency of this repo.
+// Usage: sparse_map_benchmark [n = 100000] [universe = 2^20] [passes = 100]
+
+#include <bench.h>
+#include <jkds/container/sparse_map.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace jkds::container;
+
+namespace {
+
+  struct Particle {
+    float x = 0;
+    float y = 0;
+    float vx = 1;
+    float vy = -1;
+  };
+
+  // An open-addressing map with linear probing and backward shift deletion, whose slots store
+  // the keys and the values inline.
+  template <typename Value>
+  class FlatMap {
+  private:
+    static constexpr auto empty = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::pair<std::uint32_t, Value>> slots_;
+    std::size_t mask_;
+
+    [[nodiscard]] std::size_t home(std::uint32_t key) const noexcept {
+      return (std::uint64_t(key) * 0x9E3779B97F4A7C15 >> 32) & mask_;
+    }
+
+  public:
+    explicit FlatMap(std::size_t capacity) :
+        slots_(std::bit_ceil(2 * capacity), {empty, Value{}}),
+        mask_(std::bit_ceil(2 * capacity) - 1) {
+    }
+
+    bool insert(std::uint32_t key, Value value) {
+      for (auto i = home(key);; i = (i + 1) & mask_) {
+        if (slots_[i].first == key) {
+          return false;
+        }
+        if (slots_[i].first == empty) {
+          slots_[i] = {key, std::move(value)};
+          return true;
+        }
+      }
+    }
+
+    [[nodiscard]] Value* find(std::uint32_t key) noexcept {
+      for (auto i = home(key);; i = (i + 1) & mask_) {
+        if (slots_[i].first == key) {
+          return &slots_[i].second;
+        }
+        if (slots_[i].first == empty) {
+          return nullptr;
+        }
+      }
+    }
+
+    bool erase(std::uint32_t key) {
+      auto i = home(key);
+      while (slots_[i].first != key) {
+        if (slots_[i].first == empty) {
+          return false;
+        }
+        i = (i + 1) & mask_;
+      }
+
+      // shift back the following entries which aren't in their home slot
+      for (auto j = (i + 1) & mask_; slots_[j].first != empty; j = (j + 1) & mask_) {
+        if (((j - home(slots_[j].first)) & mask_) >= ((j - i) & mask_)) {
+          slots_[i] = std::move(slots_[j]);
+          i = j;
+        }
+      }
+      slots_[i].first = empty;
+      return true;
+    }
+
+    template <typename F>
+    void for_each_value(F f) {
+      for (auto& [key, value] : slots_) {
+        if (key != empty) {
+          f(value);
+        }
+      }
+    }
+  };
+
+  struct Workload {
+    std::size_t universe;
+    std::size_t passes;
+    std::vector<std::uint32_t> keys;
+    std::vector<std::uint32_t> lookups;
+  };
+
+  template <typename Map, typename InsertF, typename FindF, typename EraseF, typename ForEachF>
+  void run(const std::string& name, const Workload& w, Map& map, InsertF insert, FindF find,
+           EraseF erase, ForEachF for_each_value) {
+    const auto n = w.keys.size();
+    std::cout << "# " << name << '\n';
+
+    bench::report("insert", bench::time_it([&]() {
+                    for (auto key : w.keys) {
+                      insert(map, key);
+                    }
+                  }),
+                  n);
+
+    bench::report("update every value", bench::time_it([&]() {
+                    for (std::size_t p = 0; p < w.passes; ++p) {
+                      for_each_value(map, [](Particle& particle) {
+                        particle.x += particle.vx;
+                        particle.y += particle.vy;
+                      });
+                    }
+                  }),
+                  n * w.passes);
+
+    double checksum = 0;
+    bench::report("find", bench::time_it([&]() {
+                    for (auto key : w.lookups) {
+                      checksum += find(map, key)->x;
+                    }
+                  }),
+                  w.lookups.size());
+
+    bench::report("erase and insert half", bench::time_it([&]() {
+                    for (std::size_t k = 0; k < n; k += 2) {
+                      erase(map, w.keys[k]);
+                    }
+                    for (std::size_t k = 0; k < n; k += 2) {
+                      insert(map, w.keys[k]);
+                    }
+                  }),
+                  n);
+
+    for_each_value(map, [&](Particle& particle) {
+      checksum += particle.y;
+    });
+    std::cout << "  checksum: " << checksum << '\n';
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 100'000);
+  const auto universe = bench::arg_or(argc, argv, 2, 1 << 20);
+  const auto passes = bench::arg_or(argc, argv, 3, 100);
+  std::cout << "n: " << n << ", universe: " << universe << ", passes: " << passes << '\n';
+
+  // n distinct random ids, and n random lookups among them
+  Workload w{universe, passes, {}, {}};
+  {
+    std::vector<std::uint32_t> ids(universe);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::mt19937_64 rng{42};
+    std::shuffle(ids.begin(), ids.end(), rng);
+    w.keys.assign(ids.begin(), ids.begin() + std::ptrdiff_t(std::min(n, universe)));
+
+    std::uniform_int_distribution<std::size_t> index{0, w.keys.size() - 1};
+    for (std::size_t k = 0; k < w.keys.size(); ++k) {
+      w.lookups.push_back(w.keys[index(rng)]);
+    }
+  }
+
+  {
+    SparseMap<std::uint32_t, Particle> map{universe};
+    run("SparseMap", w, map,
+        [](auto& m, auto key) { m.insert(key, Particle{}); },
+        [](auto& m, auto key) { return m.find(key); },
+        [](auto& m, auto key) { m.erase(key); },
+        [](auto& m, auto f) {
+          for (auto& particle : m.values()) {
+            f(particle);
+          }
+        });
+    std::cout << "  allocated pages: " << map.allocated_pages() << '\n';
+  }
+
+  {
+    std::unordered_map<std::uint32_t, Particle> map;
+    map.reserve(n);
+    run("std::unordered_map", w, map,
+        [](auto& m, auto key) { m.emplace(key, Particle{}); },
+        [](auto& m, auto key) { return &m.find(key)->second; },
+        [](auto& m, auto key) { m.erase(key); },
+        [](auto& m, auto f) {
+          for (auto& [key, particle] : m) {
+            f(particle);
+          }
+        });
+  }
+
+  {
+    FlatMap<Particle> map{n};
+    run("open addressing", w, map,
+        [](auto& m, auto key) { m.insert(key, Particle{}); },
+        [](auto& m, auto key) { return m.find(key); },
+        [](auto& m, auto key) { m.erase(key); },
+        [](auto& m, auto f) { m.for_each_value(f); });
+  }
+}
@@ -0,0 +1,133 @@
+// Clear-heavy workloads, as in per-iteration visited sets: every round marks a few random
+// elements of the universe (testing each of them first), then the set is cleared.
+// The second workload also visits the members before clearing, which a bitset can only do by
+// scanning the whole universe. SparseSet is compared with std::bitset and std::vector<bool>,
+// for a universe of 4096 elements known at compile time, and of 2^20 elements.
+// Usage: sparse_set_benchmark [rounds = 200000] [elements per round = 32]
+
+#include <bench.h>
+#include <jkds/container/sparse_set.h>
+
+#include <bitset>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jkds::container;
+
+namespace {
+
+  struct Workload {
+    std::size_t universe;
+    std::size_t rounds;
+    std::size_t per_round;
+    std::vector<std::uint32_t> elements;
+  };
+
+  // mark the elements of every round, then optionally visit the members, and clear
+  template <typename Set, typename ContainsF, typename AddF, typename VisitF, typename ClearF>
+  void run(const std::string& name, const Workload& w, bool visit, Set& set, ContainsF contains,
+           AddF add, VisitF for_each_member, ClearF clear) {
+    std::size_t checksum = 0;
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t r = 0; r < w.rounds; ++r) {
+        const auto first = w.elements.data() + r * w.per_round;
+        for (std::size_t k = 0; k < w.per_round; ++k) {
+          if (!contains(set, first[k])) {
+            add(set, first[k]);
+          }
+        }
+        if (visit) {
+          for_each_member(set, [&](std::size_t x) {
+            checksum += x;
+          });
+        }
+        clear(set);
+      }
+    });
+    bench::report(name + (visit ? ", with visit" : ""), seconds, w.rounds);
+    std::cout << "  checksum: " << checksum << '\n';
+  }
+
+  template <std::size_t N>
+  void run_universe(std::size_t rounds, std::size_t per_round) {
+    Workload w{N, rounds, per_round, std::vector<std::uint32_t>(rounds * per_round)};
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::uint32_t> element{0, N - 1};
+    for (auto& x : w.elements) {
+      x = element(rng);
+    }
+    std::cout << "universe: " << N << '\n';
+
+    for (bool visit : {false, true}) {
+      // too large for the stack, in the case of the larger universe
+      auto sparse = std::make_unique<SparseSet<N>>();
+      run("SparseSet<" + std::to_string(N) + ">", w, visit, *sparse,
+          [](auto& s, auto x) { return s.contains(x); },
+          [](auto& s, auto x) { s.add(x); },
+          [](auto& s, auto f) {
+            for (auto x : s) {
+              f(x);
+            }
+          },
+          [](auto& s) { s.clear(); });
+
+      SparseSet<> dynamic{N};
+      run("SparseSet<>", w, visit, dynamic,
+          [](auto& s, auto x) { return s.contains(x); },
+          [](auto& s, auto x) { s.add(x); },
+          [](auto& s, auto f) {
+            for (auto x : s) {
+              f(x);
+            }
+          },
+          [](auto& s) { s.clear(); });
+
+      auto bits = std::make_unique<std::bitset<N>>();
+      run("std::bitset", w, visit, *bits,
+          [](auto& s, auto x) { return s.test(x); },
+          [](auto& s, auto x) { s.set(x); },
+          [](auto& s, auto f) {
+#if defined(__GLIBCXX__)
+            // libstdc++ skips the empty words
+            for (auto x = s._Find_first(); x < N; x = s._Find_next(x)) {
+              f(x);
+            }
+#else
+            for (std::size_t x = 0; x < N; ++x) {
+              if (s.test(x)) {
+                f(x);
+              }
+            }
+#endif
+          },
+          [](auto& s) { s.reset(); });
+
+      std::vector<bool> flags(N);
+      run("std::vector<bool>", w, visit, flags,
+          [](auto& s, auto x) { return bool(s[x]); },
+          [](auto& s, auto x) { s[x] = true; },
+          [](auto& s, auto f) {
+            for (std::size_t x = 0; x < N; ++x) {
+              if (s[x]) {
+                f(x);
+              }
+            }
+          },
+          [](auto& s) { s.assign(N, false); });
+    }
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto rounds = bench::arg_or(argc, argv, 1, 200'000);
+  const auto per_round = bench::arg_or(argc, argv, 2, 32);
+  std::cout << "rounds: " << rounds << ", elements per round: " << per_round << '\n';
+
+  run_universe<4096>(rounds, per_round);
+  run_universe<(1 << 20)>(rounds / 200, per_round);
+}
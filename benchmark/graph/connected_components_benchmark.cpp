@@ -0,0 +1,47 @@
+// Connected components of a random graph: jkds::graph::connected_components against a loop
+// over DisjointSet::unite and DenseDisjointSet::unite.
+// Usage: connected_components_benchmark [vertices = 10000000] [edges = 100000000]
+//                                       [threads = hardware concurrency]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/graph/connected_components.h>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace jkds::container;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 100'000'000);
+  const auto threads = bench::arg_or(argc, argv, 3, jkds::util::default_num_threads());
+  const auto edges = bench::random_edges(n, m);
+  std::cout << "vertices: " << n << ", edges: " << m << ", threads: " << threads << '\n';
+
+  DisjointSet<std::size_t> keyed{jkds::util::range<std::size_t>(n)};
+  const auto keyed_seconds = bench::time_it([&]() {
+    for (auto&& [u, v] : edges) {
+      keyed.unite(u, v);
+    }
+  });
+  bench::report("loop over DisjointSet<std::size_t>::unite", keyed_seconds, m);
+
+  DenseDisjointSet dense{n};
+  const auto dense_seconds = bench::time_it([&]() {
+    for (auto&& [u, v] : edges) {
+      dense.unite(u, v);
+    }
+  });
+  bench::report("loop over DenseDisjointSet::unite", dense_seconds, m);
+
+  std::vector<std::size_t> labels;
+  const auto parallel_seconds = bench::time_it([&]() {
+    labels = jkds::graph::connected_components(edges, n, threads);
+  });
+  bench::report("connected_components (labels included)", parallel_seconds, m);
+
+  const auto components = n == 0 ? 0 : *std::max_element(labels.begin(), labels.end()) + 1;
+  std::cout << "components: " << components << '\n';
+}
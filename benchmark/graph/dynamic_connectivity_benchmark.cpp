@@ -0,0 +1,67 @@
+// Offline dynamic connectivity over a synthetic stream of edge insertions, edge removals
+// and connectivity queries, plus the raw unite/rollback throughput of RollbackDisjointSet.
+// Usage: dynamic_connectivity_benchmark [vertices = 1000000] [events = 10000000]
+
+#include <bench.h>
+#include <jkds/container/rollback_disjoint_set.h>
+#include <jkds/graph/dynamic_connectivity.h>
+
+#include <iostream>
+#include <random>
+
+using namespace jkds::graph;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 1'000'000);
+  const auto num_events = bench::arg_or(argc, argv, 2, 10'000'000);
+  std::cout << "vertices: " << n << ", events: " << num_events << '\n';
+
+  // 40% insertions, 30% removals of a random alive edge, 30% queries
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<std::size_t> vertex{0, n - 1};
+  std::uniform_int_distribution<int> action{0, 9};
+  std::vector<Event> events;
+  std::vector<edge_t> alive;
+  events.reserve(num_events);
+
+  for (std::size_t k = 0; k < num_events; ++k) {
+    const auto a = action(rng);
+    if (a < 4 || (a < 7 && alive.empty())) {
+      const auto u = vertex(rng), v = vertex(rng);
+      events.push_back({event_type::add_edge, u, v});
+      alive.emplace_back(u, v);
+    } else if (a < 7) {
+      std::uniform_int_distribution<std::size_t> pick{0, alive.size() - 1};
+      auto& edge = alive[pick(rng)];
+      events.push_back({event_type::remove_edge, edge.first, edge.second});
+      std::swap(edge, alive.back());
+      alive.pop_back();
+    } else {
+      events.push_back({event_type::query, vertex(rng), vertex(rng)});
+    }
+  }
+
+  std::size_t connected = 0;
+  const auto seconds = bench::time_it([&]() {
+    for (bool answer : offline_dynamic_connectivity(n, events)) {
+      connected += answer;
+    }
+  });
+  bench::report("offline_dynamic_connectivity", seconds, num_events);
+  std::cout << "connected queries: " << connected << '\n';
+
+  // unite a batch of random edges, then roll them back, repeatedly
+  jkds::container::RollbackDisjointSet ds{n};
+  const auto edges = bench::random_edges(n, n / 2);
+  constexpr std::size_t rounds = 10;
+  const auto rollback_seconds = bench::time_it([&]() {
+    for (std::size_t round = 0; round < rounds; ++round) {
+      const auto snapshot = ds.snapshot();
+      for (auto&& [u, v] : edges) {
+        ds.unite(u, v);
+      }
+      ds.rollback(snapshot);
+    }
+  });
+  bench::report("RollbackDisjointSet unite + rollback", rollback_seconds, rounds * edges.size());
+}
@@ -0,0 +1,144 @@
+// Connected-component labeling of synthetic 2D masks: random noise (many small components),
+// random disks (few large blobs), and vertical stripes (long runs in every row).
+// grid_connected_components on 1 and on every hardware thread is compared with a per-pixel
+// DenseDisjointSet over the implicit grid, and with DisjointSet<uint64_t> over packed
+// coordinates, which is only run on the first rows since hashing every pixel is much slower.
+// Usage: grid_connected_components_benchmark [side = 8192]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/graph/grid_connected_components.h>
+#include <jkds/util/parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace jkds::graph;
+
+namespace {
+
+  std::vector<std::uint8_t> noise_mask(std::size_t side) {
+    std::mt19937_64 rng{42};
+    std::vector<std::uint8_t> mask(side * side);
+    for (auto& cell : mask) {
+      cell = (rng() & 3) != 0;
+    }
+    return mask;
+  }
+
+  std::vector<std::uint8_t> disks_mask(std::size_t side) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::ptrdiff_t> center{0, std::ptrdiff_t(side) - 1};
+    std::uniform_int_distribution<std::ptrdiff_t> radius{4, 64};
+    std::vector<std::uint8_t> mask(side * side, 0);
+
+    for (std::size_t k = 0; k < side * side / 4096; ++k) {
+      const auto cx = center(rng), cy = center(rng), r = radius(rng);
+      for (auto y = std::max<std::ptrdiff_t>(0, cy - r);
+           y <= std::min<std::ptrdiff_t>(side - 1, cy + r); ++y) {
+        for (auto x = std::max<std::ptrdiff_t>(0, cx - r);
+             x <= std::min<std::ptrdiff_t>(side - 1, cx + r); ++x) {
+          if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r) {
+            mask[y * side + x] = 255;
+          }
+        }
+      }
+    }
+    return mask;
+  }
+
+  std::vector<std::uint8_t> stripes_mask(std::size_t side) {
+    std::vector<std::uint8_t> mask(side * side);
+    for (std::size_t i = 0; i < mask.size(); ++i) {
+      mask[i] = (i % side) % 256 < 200;
+    }
+    return mask;
+  }
+
+  // 8-connected labeling, uniting every foreground pixel with its previous neighbors
+  template <typename DS, typename IdF>
+  std::size_t pixel_labeling(const std::vector<std::uint8_t>& mask, std::size_t side,
+                             std::size_t rows, DS& ds, IdF id_of) {
+    for (std::size_t y = 0; y < rows; ++y) {
+      for (std::size_t x = 0; x < side; ++x) {
+        if (!mask[y * side + x]) {
+          continue;
+        }
+        auto link = [&](std::size_t nx, std::size_t ny) {
+          if (mask[ny * side + nx]) {
+            ds.unite(id_of(x, y), id_of(nx, ny));
+          }
+        };
+        if (x > 0) {
+          link(x - 1, y);
+        }
+        if (y > 0) {
+          link(x, y - 1);
+          if (x > 0) {
+            link(x - 1, y - 1);
+          }
+          if (x + 1 < side) {
+            link(x + 1, y - 1);
+          }
+        }
+      }
+    }
+    return ds.num_sets();
+  }
+
+  void run(const std::string& name, const std::vector<std::uint8_t>& mask, std::size_t side) {
+    const auto pixels = mask.size();
+    std::size_t num_components = 0;
+
+    for (std::size_t num_threads : {std::size_t(1), jkds::util::default_num_threads()}) {
+      const auto seconds = bench::time_it([&]() {
+        num_components =
+            grid_connected_components(mask, side, side, grid_connectivity::full, num_threads)
+                .num_components;
+      });
+      bench::report(name + ": grid_connected_components, " + std::to_string(num_threads) +
+                        " threads",
+                    seconds, pixels);
+    }
+
+    const auto dense_seconds = bench::time_it([&]() {
+      jkds::container::DenseDisjointSet ds{pixels};
+      pixel_labeling(mask, side, side, ds, [side](std::size_t x, std::size_t y) {
+        return y * side + x;
+      });
+    });
+    bench::report(name + ": per-pixel DenseDisjointSet", dense_seconds, pixels);
+
+    const auto rows = std::max<std::size_t>(1, side / 16);
+    const auto hashed_seconds = bench::time_it([&]() {
+      std::vector<std::uint64_t> keys(rows * side);
+      for (std::size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = (std::uint64_t(i / side) << 32) | (i % side);
+      }
+      jkds::container::DisjointSet<std::uint64_t> ds{std::move(keys)};
+      pixel_labeling(mask, side, rows, ds, [](std::size_t x, std::size_t y) {
+        return (std::uint64_t(y) << 32) | x;
+      });
+    });
+    bench::report(name + ": per-pixel DisjointSet<uint64_t>, first " + std::to_string(rows) +
+                      " rows",
+                  hashed_seconds, rows * side);
+
+    std::cout << name << ": " << num_components << " components\n";
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto side = bench::arg_or(argc, argv, 1, 8192);
+  std::cout << "mask: " << side << " x " << side << '\n';
+
+  run("noise", noise_mask(side), side);
+  run("disks", disks_mask(side), side);
+  run("stripes", stripes_mask(side), side);
+}
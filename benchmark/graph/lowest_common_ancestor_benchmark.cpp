@@ -0,0 +1,93 @@
+// Lowest common ancestor queries on random trees: a random recursive tree (every vertex picks
+// a uniformly random earlier parent, so the depth is logarithmic), and a deep tree (every
+// vertex picks one of the 4 previous vertices, so the depth is linear). Tarjan's offline
+// algorithm answers the whole batch, while LowestCommonAncestor is preprocessed once and then
+// answers the queries online. Finally, bridges runs on the tree plus one random edge every 10
+// vertices, which leaves most of the tree edges as bridges in the random recursive tree.
+// Usage: lowest_common_ancestor_benchmark [vertices = 10000000] [queries = 10000000]
+
+#include <bench.h>
+#include <jkds/graph/lowest_common_ancestor.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace jkds::graph;
+
+namespace {
+
+  void run(const std::string& name, std::vector<std::size_t> parents, std::size_t q) {
+    const auto n = parents.size();
+    std::mt19937_64 rng{7};
+    std::uniform_int_distribution<std::size_t> vertex{0, n - 1};
+    std::vector<std::pair<std::size_t, std::size_t>> queries(q);
+    for (auto& [u, v] : queries) {
+      u = vertex(rng);
+      v = vertex(rng);
+    }
+
+    std::vector<std::size_t> offline;
+    const auto offline_seconds = bench::time_it([&]() {
+      offline = offline_lowest_common_ancestors(parents, queries);
+    });
+    bench::report(name + ": offline_lowest_common_ancestors", offline_seconds, q);
+
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    edges.reserve(n + n / 10);
+    for (std::size_t u = 0; u < n; ++u) {
+      if (parents[u] != u) {
+        edges.emplace_back(u, parents[u]);
+      }
+    }
+    for (std::size_t k = 0; k < n / 10; ++k) {
+      edges.emplace_back(vertex(rng), vertex(rng));
+    }
+
+    std::optional<LowestCommonAncestor> lca;
+    const auto build_seconds = bench::time_it([&]() {
+      lca.emplace(std::move(parents));
+    });
+    bench::report(name + ": LowestCommonAncestor preprocessing", build_seconds, n);
+
+    std::size_t mismatches = 0;
+    const auto query_seconds = bench::time_it([&]() {
+      for (std::size_t k = 0; k < q; ++k) {
+        mismatches += lca->lca(queries[k].first, queries[k].second) != offline[k];
+      }
+    });
+    bench::report(name + ": LowestCommonAncestor::lca", query_seconds, q);
+    std::cout << name << ": " << mismatches << " mismatches\n";
+
+    std::size_t num_bridges = 0;
+    const auto bridges_seconds = bench::time_it([&]() {
+      num_bridges = bridges(n, edges).size();
+    });
+    bench::report(name + ": bridges", bridges_seconds, edges.size());
+    std::cout << name << ": " << num_bridges << " bridges\n";
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto q = bench::arg_or(argc, argv, 2, 10'000'000);
+  std::cout << "vertices: " << n << ", queries: " << q << '\n';
+
+  std::mt19937_64 rng{42};
+  std::vector<std::size_t> parents(n, 0);
+  for (std::size_t u = 1; u < n; ++u) {
+    parents[u] = std::uniform_int_distribution<std::size_t>{0, u - 1}(rng);
+  }
+  run("random recursive tree", parents, q);
+
+  for (std::size_t u = 1; u < n; ++u) {
+    parents[u] = u - std::uniform_int_distribution<std::size_t>{1, std::min<std::size_t>(u, 4)}(rng);
+  }
+  run("deep tree", std::move(parents), q);
+}
@@ -0,0 +1,63 @@
+// Single-linkage clustering of a random weighted graph: std::sort followed by a loop over
+// DisjointSet::unite, against jkds::graph::single_linkage with Kruskal and Boruvka.
+// Usage: minimum_spanning_forest_benchmark [vertices = 1000000] [edges = 10000000]
+//                                          [clusters = 1] [threads = hardware concurrency]
+
+#include <bench.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/graph/minimum_spanning_forest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+using namespace jkds::graph;
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 1'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 10'000'000);
+  const auto k = bench::arg_or(argc, argv, 3, 1);
+  const auto threads = bench::arg_or(argc, argv, 4, jkds::util::default_num_threads());
+  std::cout << "vertices: " << n << ", edges: " << m << ", clusters: " << k
+            << ", threads: " << threads << '\n';
+
+  std::mt19937_64 rng{42};
+  std::uniform_real_distribution<float> weight{0.0f, 1.0f};
+  std::vector<WeightedEdge<float>> edges;
+  edges.reserve(m);
+  for (auto&& [u, v] : bench::random_edges(n, m)) {
+    edges.push_back({u, v, weight(rng)});
+  }
+
+  std::size_t naive_merges = 0;
+  const auto naive_seconds = bench::time_it([&]() {
+    auto sorted = edges;
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](auto&& a, auto&& b) { return a.weight < b.weight; });
+
+    jkds::container::DisjointSet<std::size_t> ds{jkds::util::range<std::size_t>(n)};
+    for (auto&& edge : sorted) {
+      if (ds.num_sets() <= k) {
+        break;
+      }
+      naive_merges += ds.unite(edge.u, edge.v);
+    }
+  });
+  bench::report("std::stable_sort + DisjointSet<std::size_t>::unite", naive_seconds, m);
+
+  for (auto [name, algorithm] : {std::pair{"single_linkage (kruskal)", mst_algorithm::kruskal},
+                                 std::pair{"single_linkage (boruvka)", mst_algorithm::boruvka}}) {
+    Dendrogram<float> dendrogram;
+    const auto seconds = bench::time_it([&]() {
+      dendrogram = single_linkage(n, edges, k, algorithm, threads);
+    });
+    bench::report(name, seconds, m);
+
+    if (dendrogram.merges.size() != naive_merges) {
+      std::cout << "mismatch: " << dendrogram.merges.size() << " merges instead of "
+                << naive_merges << '\n';
+    }
+  }
+
+  std::cout << "merges: " << naive_merges << ", clusters: " << n - naive_merges << '\n';
+}
@@ -0,0 +1,92 @@
+// Connected components of a random graph stored in a binary file of 32-bit vertex ids:
+// reading the whole file into a std::vector and looping over DisjointSet::unite or
+// DenseDisjointSet::unite, against jkds::graph::stream_connected_components.
+// The edge file is generated in the temporary directory, and removed at the end.
+// Usage: streaming_connected_components_benchmark [vertices = 10000000] [edges = 100000000]
+
+#include <bench.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/graph/streaming_connected_components.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace jkds::graph;
+
+namespace {
+
+  // write m random edges over [0, n) to path, a block at a time
+  void generate_edges(const std::filesystem::path& path, std::size_t n, std::size_t m) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::uint32_t> dist{0, std::uint32_t(n - 1)};
+    std::ofstream out(path, std::ios::binary);
+    std::vector<std::uint32_t> block;
+
+    for (std::size_t k = 0; k < m; ++k) {
+      block.push_back(dist(rng));
+      block.push_back(dist(rng));
+      if (block.size() == (1 << 20) || k + 1 == m) {
+        out.write(reinterpret_cast<const char*>(block.data()),
+                  std::streamsize(block.size() * sizeof(std::uint32_t)));
+        block.clear();
+      }
+    }
+  }
+
+  std::vector<std::uint32_t> read_edges(const std::filesystem::path& path) {
+    std::vector<std::uint32_t> ids(std::filesystem::file_size(path) / sizeof(std::uint32_t));
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(ids.data()), std::streamsize(ids.size() * sizeof(ids[0])));
+    return ids;
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+  const auto m = bench::arg_or(argc, argv, 2, 100'000'000);
+  const auto directory = std::filesystem::temp_directory_path();
+  const auto edges_path = directory / "jkds_streaming_benchmark_edges";
+  const auto labels_path = directory / "jkds_streaming_benchmark_labels";
+  std::cout << "vertices: " << n << ", edges: " << m << ", file: " << edges_path << '\n';
+
+  generate_edges(edges_path, n, m);
+
+  const auto keyed_seconds = bench::time_it([&]() {
+    const auto ids = read_edges(edges_path);
+    jkds::container::DisjointSet<std::size_t> ds{jkds::util::range<std::size_t>(n)};
+    for (std::size_t k = 0; k < ids.size(); k += 2) {
+      ds.unite(ids[k], ids[k + 1]);
+    }
+  });
+  bench::report("read into std::vector + DisjointSet<std::size_t>::unite", keyed_seconds, m);
+
+  const auto dense_seconds = bench::time_it([&]() {
+    const auto ids = read_edges(edges_path);
+    jkds::container::DenseDisjointSet ds{n};
+    for (std::size_t k = 0; k < ids.size(); k += 2) {
+      ds.unite(ids[k], ids[k + 1]);
+    }
+  });
+  bench::report("read into std::vector + DenseDisjointSet::unite", dense_seconds, m);
+
+  for (auto [name, access] :
+       {std::pair{"stream_connected_components (mapped, labels included)",
+                  edge_file_access::mapped},
+        std::pair{"stream_connected_components (chunked, labels included)",
+                  edge_file_access::chunked}}) {
+    const auto stats = stream_connected_components<std::uint32_t>(edges_path, n, labels_path,
+                                                                  access);
+    bench::report(name, stats.seconds, stats.num_edges);
+    std::cout << "  edges/s: " << stats.edges_per_second()
+              << ", components: " << stats.num_components << '\n';
+  }
+
+  std::filesystem::remove(edges_path);
+  std::filesystem::remove(labels_path);
+}
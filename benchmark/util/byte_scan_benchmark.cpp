@@ -0,0 +1,163 @@
+// Scanning a log-like buffer for a class of delimiter bytes, counting the matches: the scalar
+// loop over SparseByteSet::contains, strpbrk, memchr (for a single byte), and find_first_of,
+// match_bitmap and split_by with every instruction set supported by the running processor.
+// The "lines" workload only looks for newlines (one every ~100 bytes), while the "tokens"
+// workload looks for spaces, tabs, commas and newlines (one every ~6 bytes).
+// Usage: byte_scan_benchmark [buffer size in MB = 16] [repetitions = 10]
+
+#include <bench.h>
+#include <jkds/container/sparse_byte_set.h>
+#include <jkds/util/byte_scan.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace jkds::util;
+using jkds::container::SparseByteSet;
+
+namespace {
+
+  // words of 1 to 10 lowercase letters, separated by spaces, commas and tabs, in lines of about
+  // 100 bytes; the buffer has no NUL bytes, so that strpbrk sees all of it
+  std::string log_buffer(std::size_t size) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    std::uniform_int_distribution<int> length{1, 10};
+    std::uniform_int_distribution<int> separator{0, 9};
+
+    std::string buffer;
+    buffer.reserve(size + 16);
+    std::size_t line = 0;
+    while (buffer.size() < size) {
+      for (auto k = length(rng); k > 0; --k) {
+        buffer.push_back(static_cast<char>(letter(rng)));
+      }
+      if (buffer.size() - line >= 100) {
+        buffer.push_back('\n');
+        line = buffer.size();
+      } else {
+        const auto s = separator(rng);
+        buffer.push_back(s == 0 ? ',' : s == 1 ? '\t' : ' ');
+      }
+    }
+    buffer.resize(size);
+    return buffer;
+  }
+
+  template <typename F>
+  void run(const std::string& name, const std::string& buffer, std::size_t repetitions, F count) {
+    std::size_t matches = 0;
+    const auto seconds = bench::time_it([&]() {
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        matches += count();
+      }
+    });
+    const auto bytes = double(buffer.size()) * double(repetitions);
+    std::cout << name << ": " << seconds << " s, " << (bytes / seconds / 1e9) << " GB/s ("
+              << matches / repetitions << " matches)\n";
+  }
+
+  const char* isa_name(byte_scan_isa isa) {
+    switch (isa) {
+      case byte_scan_isa::avx2:
+        return "avx2";
+      case byte_scan_isa::ssse3:
+        return "ssse3";
+      default:
+        return "scalar";
+    }
+  }
+
+  void run_workload(const std::string& workload, const std::string& buffer,
+                    std::string_view delimiters, std::size_t repetitions) {
+    std::cout << "# " << workload << "\n";
+
+    SparseByteSet set;
+    for (auto c : delimiters) {
+      set.add(static_cast<std::uint8_t>(c));
+    }
+    const ByteClass byte_class{set};
+    const std::string delimiters_z{delimiters};
+
+    run("SparseByteSet::contains loop", buffer, repetitions, [&]() {
+      std::size_t matches = 0;
+      for (auto c : buffer) {
+        matches += set.contains(static_cast<std::uint8_t>(c));
+      }
+      return matches;
+    });
+
+    run("strpbrk", buffer, repetitions, [&]() {
+      std::size_t matches = 0;
+      for (auto p = std::strpbrk(buffer.c_str(), delimiters_z.c_str()); p != nullptr;
+           p = std::strpbrk(p + 1, delimiters_z.c_str())) {
+        ++matches;
+      }
+      return matches;
+    });
+
+    if (delimiters.size() == 1) {
+      run("memchr", buffer, repetitions, [&]() {
+        std::size_t matches = 0;
+        const auto end = buffer.data() + buffer.size();
+        for (auto p = buffer.data();
+             (p = static_cast<const char*>(std::memchr(p, delimiters[0], end - p))) != nullptr;
+             ++p) {
+          ++matches;
+        }
+        return matches;
+      });
+    }
+
+    for (auto isa : {byte_scan_isa::scalar, byte_scan_isa::ssse3, byte_scan_isa::avx2}) {
+      if (isa > best_byte_scan_isa()) {
+        continue;
+      }
+      const std::string suffix = std::string(" (") + isa_name(isa) + ")";
+
+      run("find_first_of" + suffix, buffer, repetitions, [&]() {
+        std::size_t matches = 0;
+        for (auto i = find_first_of(buffer, byte_class, 0, isa); i != std::string_view::npos;
+             i = find_first_of(buffer, byte_class, i + 1, isa)) {
+          ++matches;
+        }
+        return matches;
+      });
+
+      std::vector<std::uint64_t> bitmap((buffer.size() + 63) / 64);
+      run("match_bitmap" + suffix, buffer, repetitions, [&]() {
+        match_bitmap(buffer, byte_class, bitmap, isa);
+        std::size_t matches = 0;
+        for (auto word : bitmap) {
+          matches += static_cast<std::size_t>(std::popcount(word));
+        }
+        return matches;
+      });
+
+      run("split_by" + suffix, buffer, repetitions, [&]() {
+        std::size_t tokens = 0;
+        for ([[maybe_unused]] auto token : split_by(buffer, byte_class, isa)) {
+          ++tokens;
+        }
+        return tokens - 1;
+      });
+    }
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  const auto size = bench::arg_or(argc, argv, 1, 16) << 20;
+  const auto repetitions = bench::arg_or(argc, argv, 2, 10);
+  const auto buffer = log_buffer(size);
+
+  std::cout << "buffer: " << size << " bytes, best instruction set: "
+            << isa_name(best_byte_scan_isa()) << "\n";
+  run_workload("lines", buffer, "\n", repetitions);
+  run_workload("tokens", buffer, " \t,\n", repetitions);
+}
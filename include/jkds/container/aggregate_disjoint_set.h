@@ -0,0 +1,202 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "dense_disjoint_set.h"
+#include "keyed_index.h"
+#include "partition.h"
+
+namespace jkds::container {
+
+  /***
+   * AggregateDisjointSet
+   *
+   * A Disjoint Set data structure (also known as Union-Find) where every set carries an
+   * aggregate of type A, e.g. the sum of the weights of its elements, or their minimum
+   * timestamp. T is the type of the elements, and Combine is an associative binary operation
+   * over A (std::plus<> by default), i.e. (A, Combine) is a semigroup.
+   *
+   * Every element starts with its own aggregate, and whenever two sets are united, their
+   * aggregates are combined in the representative of the union, in the order of the unite
+   * arguments. Thus the aggregate of any set can be read in almost constant time, without
+   * snapshotting the sets. An optional callback observes the two aggregates of every merge.
+   * As in DisjointSet<T>, the elements are mapped to the indexes of a DenseDisjointSet by a
+   * detail::KeyedIndex, hence an implementation of std::hash<T> is required.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - add(const T&, A)
+   * - unite(const T&, const T&)
+   * - unite(const T&, const T&, OnMerge&&)
+   * - are_connected(const T&, const T&)
+   * - set_size(const T&)
+   * - aggregate_of(const T&)
+   * - accumulate(const T&, const A&)
+   * - get_partition()
+   */
+  template <typename T, typename A, typename Combine = std::plus<>>
+  class AggregateDisjointSet {
+  private:
+    detail::KeyedIndex<T> index_;
+
+    // the nodes are declared after the keys, which size them
+    DenseDisjointSet sets_;
+
+    // aggregates_[i] is the aggregate of the set represented by i, only meaningful for
+    // representatives
+    std::vector<A> aggregates_;
+    Combine combine_;
+
+  public:
+    AggregateDisjointSet() = delete;
+
+    // aggregates[i] is the initial aggregate of the singleton set {inputs[i]}. Throw
+    // std::invalid_argument if an input is repeated, or if there isn't one aggregate per input
+    AggregateDisjointSet(std::vector<T> inputs, std::vector<A> aggregates,
+                         Combine combine = {}) :
+        index_(std::make_move_iterator(inputs.begin()), std::make_move_iterator(inputs.end())),
+        sets_(index_.size()), aggregates_(std::move(aggregates)), combine_(std::move(combine)) {
+      // moving the inputs into the index leaves their number unchanged
+      if (inputs.size() != aggregates_.size()) {
+        throw std::invalid_argument("one aggregate per input is required");
+      }
+      if (index_.size() != inputs.size()) {
+        throw std::invalid_argument("repeated element");
+      }
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return sets_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return sets_.num_sets();
+    }
+
+    /***
+     * add
+     *
+     * Add a new singleton set {x}, whose aggregate is a, returning the index of the resulting
+     * node. Throw std::invalid_argument if x is already an element. If it throws, nothing is
+     * added.
+     * Time: O(1) amortized, Space: O(1)
+     */
+    std::size_t add(const T& x, A a) {
+      const auto i = index_.add(x);
+      try {
+        aggregates_.push_back(std::move(a));
+        sets_.add();
+      } catch (...) {
+        // every index must stay below size()
+        if (aggregates_.size() > i) {
+          aggregates_.pop_back();
+        }
+        index_.pop_back();
+        throw;
+      }
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Merge the two sets which contain the x and y elements, respectively, into a new set
+     * whose aggregate is combine(aggregate_of(x), aggregate_of(y)). If the sets are disjoint,
+     * on_merge(aggregate_of(x), aggregate_of(y)) is invoked once combine has returned, right
+     * before the sets are united.
+     * Return true iff x and y were in different sets before the call. The aggregates are
+     * passed to combine as const references and replaced only once on_merge returns, so if
+     * either throws, the sets and their aggregates are left unchanged, and on_merge never sees
+     * a merge that doesn't happen because of combine.
+     * Time: O(lg^* n) amortized, plus the cost of combine, Space: O(1)
+     */
+    template <typename OnMerge>
+    bool unite(const T& x, const T& y, OnMerge&& on_merge) {
+      const auto i = sets_.find(index_.at(x));
+      const auto j = sets_.find(index_.at(y));
+
+      if (i == j) {
+        return false;
+      }
+
+      A combined =
+          std::invoke(combine_, std::as_const(aggregates_[i]), std::as_const(aggregates_[j]));
+      std::invoke(on_merge, std::as_const(aggregates_[i]), std::as_const(aggregates_[j]));
+
+      sets_.unite(i, j);
+      aggregates_[sets_.find(i)] = std::move(combined);
+      return true;
+    }
+
+    bool unite(const T& x, const T& y) {
+      return unite(x, y, [](const A&, const A&) {});
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(const T& x, const T& y) {
+      return sets_.are_connected(index_.at(x), index_.at(y));
+    }
+
+    /***
+     * set_size
+     *
+     * Return the number of elements in the set containing x.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] std::size_t set_size(const T& x) {
+      return sets_.set_size(index_.at(x));
+    }
+
+    /***
+     * aggregate_of
+     *
+     * Return the aggregate of the set containing x. The reference is invalidated by the next
+     * call to add, unite or accumulate.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] const A& aggregate_of(const T& x) {
+      return aggregates_[sets_.find(index_.at(x))];
+    }
+
+    /***
+     * accumulate
+     *
+     * Fold a new value into the aggregate of the set containing x, which becomes
+     * combine(aggregate_of(x), value). As in unite, the aggregate is passed to combine as a
+     * const reference, and replaced only once combine returns, so if combine throws, the
+     * aggregate is left unchanged.
+     * Time: O(lg^* n) amortized, plus the cost of combine, Space: O(1)
+     */
+    void accumulate(const T& x, const A& value) {
+      auto& aggregate = aggregates_[sets_.find(index_.at(x))];
+      A combined = std::invoke(combine_, std::as_const(aggregate), value);
+      aggregate = std::move(combined);
+    }
+
+    /***
+     * get_partition
+     *
+     * Snapshot the representative sets as a Partition, i.e. in the CSR format.
+     * Sets are ordered by their first added element, and the members of every set are sorted
+     * by insertion order.
+     * Time: O(n lg^* n), Space: O(n)
+     */
+    [[nodiscard]] Partition<T> get_partition() {
+      return sets_.get_partition(1, [this](std::size_t i) {
+        return index_.key(i);
+      });
+    }
+  };
+}  // namespace jkds::container
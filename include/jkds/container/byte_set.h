@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+#include "sparse_byte_set.h"
+
+namespace jkds::container {
+
+  /***
+   * ByteSet
+   *
+   * A set of bytes stored as a 256-bit bitmap, i.e. four 64-bit words, where the bit b % 64 of
+   * the word b / 64 is set iff the byte b is a member. Unlike SparseByteSet, it supports the
+   * set algebra (union, intersection, difference and complement, a word at a time), erasures,
+   * iteration in increasing order, and rank/select, and every method is constexpr, so that
+   * character classes can be computed at compile time. The words can be loaded directly into
+   * a SIMD register.
+   *
+   * Public methods:
+   * - size()
+   * - empty()
+   * - contains(uint8_t)
+   * - add(uint8_t)
+   * - erase(uint8_t)
+   * - clear()
+   * - rank(uint8_t)
+   * - select(std::size_t)
+   * - words()
+   * - begin()
+   * - end()
+   * - operators |, &, -, ~, |=, &=, -=, ==
+   */
+  class ByteSet {
+  private:
+    std::array<std::uint64_t, 4> words_{};
+
+    [[nodiscard]] static constexpr std::uint64_t bit(std::uint8_t byte) noexcept {
+      return std::uint64_t(1) << (byte & 63);
+    }
+
+    // Return the position of the k-th set bit of word, with k < popcount(word), without
+    // branches: the byte-wise prefix sums of the popcounts are compared with k in parallel, as
+    // in "Broadword Implementation of Rank/Select Queries", by Sebastiano Vigna.
+    [[nodiscard]] static constexpr std::size_t select_in_word(std::uint64_t word,
+                                                             std::size_t k) noexcept {
+      constexpr std::uint64_t ones = 0x0101010101010101;
+      constexpr std::uint64_t highs = 0x8080808080808080;
+
+      auto counts = word - ((word >> 1) & 0x5555555555555555);
+      counts = (counts & 0x3333333333333333) + ((counts >> 2) & 0x3333333333333333);
+      counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0F;
+      const auto prefix_sums = counts * ones;
+
+      // the high bit of every byte is set iff its prefix sum is at most k
+      const auto at_most_k = ((k * ones | highs) - prefix_sums) & highs;
+      const auto place = static_cast<std::size_t>((at_most_k >> 7) * ones >> 56) * 8;
+      k -= static_cast<std::size_t>((prefix_sums << 8) >> place & 0xFF);
+
+      auto byte = (word >> place) & 0xFF;
+      for (; k > 0; --k) {
+        byte &= byte - 1;
+      }
+      return place + static_cast<std::size_t>(std::countr_zero(byte));
+    }
+
+  public:
+    using value_type = std::uint8_t;
+
+    // 256 is 2^8
+    static constexpr std::size_t capacity = 256;
+
+    // Iterates over the members of a ByteSet in increasing order, a set bit at a time.
+    class const_iterator {
+    private:
+      const std::array<std::uint64_t, 4>* words_ = nullptr;
+      std::size_t word_ = 4;
+
+      // the members of word_ which haven't been visited yet
+      std::uint64_t mask_ = 0;
+
+      constexpr void skip_empty_words() noexcept {
+        while (mask_ == 0 && word_ < 4) {
+          if (++word_ < 4) {
+            mask_ = (*words_)[word_];
+          }
+        }
+      }
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::uint8_t;
+      using difference_type = std::ptrdiff_t;
+
+      constexpr const_iterator() = default;
+
+      constexpr const_iterator(const std::array<std::uint64_t, 4>* words, std::size_t word) :
+          words_(words), word_(word), mask_(word < 4 ? (*words)[word] : 0) {
+        skip_empty_words();
+      }
+
+      [[nodiscard]] constexpr std::uint8_t operator*() const noexcept {
+        return static_cast<std::uint8_t>(word_ * 64 +
+                                         static_cast<std::size_t>(std::countr_zero(mask_)));
+      }
+
+      constexpr const_iterator& operator++() noexcept {
+        mask_ &= mask_ - 1;
+        skip_empty_words();
+        return *this;
+      }
+
+      constexpr const_iterator operator++(int) noexcept {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      [[nodiscard]] constexpr bool operator==(const const_iterator& other) const noexcept {
+        return word_ == other.word_ && mask_ == other.mask_;
+      }
+    };
+
+    constexpr ByteSet() = default;
+
+    // the set of the bytes of the given string
+    constexpr explicit ByteSet(std::string_view bytes) {
+      for (auto c : bytes) {
+        add(static_cast<std::uint8_t>(c));
+      }
+    }
+
+    // the set of the bytes of the given SparseByteSet
+    constexpr explicit ByteSet(const SparseByteSet& bytes) {
+      for (auto byte : bytes) {
+        add(byte);
+      }
+    }
+
+    // the set of the given words, where the bit b % 64 of words[b / 64] is set iff b is a member
+    constexpr explicit ByteSet(const std::array<std::uint64_t, 4>& words) : words_(words) {
+    }
+
+    /***
+     * size
+     *
+     * Return the number of members.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+      std::size_t count = 0;
+      for (auto word : words_) {
+        count += static_cast<std::size_t>(std::popcount(word));
+      }
+      return count;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+      return (words_[0] | words_[1] | words_[2] | words_[3]) == 0;
+    }
+
+    // return true iff the given byte is a member
+    [[nodiscard]] constexpr bool contains(std::uint8_t byte) const noexcept {
+      return (words_[byte >> 6] & bit(byte)) != 0;
+    }
+
+    // add the given byte, returning true iff it wasn't a member
+    constexpr bool add(std::uint8_t byte) noexcept {
+      const auto added = !contains(byte);
+      words_[byte >> 6] |= bit(byte);
+      return added;
+    }
+
+    // remove the given byte, returning true iff it was a member
+    constexpr bool erase(std::uint8_t byte) noexcept {
+      const auto erased = contains(byte);
+      words_[byte >> 6] &= ~bit(byte);
+      return erased;
+    }
+
+    constexpr void clear() noexcept {
+      words_ = {};
+    }
+
+    /***
+     * rank
+     *
+     * Return the number of members smaller than the given byte.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] constexpr std::size_t rank(std::uint8_t byte) const noexcept {
+      std::size_t count = 0;
+      for (std::size_t w = 0; w < std::size_t(byte >> 6); ++w) {
+        count += static_cast<std::size_t>(std::popcount(words_[w]));
+      }
+      return count +
+             static_cast<std::size_t>(std::popcount(words_[byte >> 6] & (bit(byte) - 1)));
+    }
+
+    /***
+     * select
+     *
+     * Return the k-th smallest member, counting from 0, so that select(rank(b)) == b for every
+     * member b. Throw std::out_of_range if k >= size().
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] constexpr std::uint8_t select(std::size_t k) const {
+      for (std::size_t w = 0; w < 4; ++w) {
+        const auto count = static_cast<std::size_t>(std::popcount(words_[w]));
+        if (k < count) {
+          return static_cast<std::uint8_t>(w * 64 + select_in_word(words_[w], k));
+        }
+        k -= count;
+      }
+      throw std::out_of_range("ByteSet: select out of range");
+    }
+
+    // return the four words of the bitmap
+    [[nodiscard]] constexpr const std::array<std::uint64_t, 4>& words() const noexcept {
+      return words_;
+    }
+
+    // iterate over the members in increasing order
+    [[nodiscard]] constexpr const_iterator begin() const noexcept {
+      return const_iterator(&words_, 0);
+    }
+
+    [[nodiscard]] constexpr const_iterator end() const noexcept {
+      return const_iterator(&words_, 4);
+    }
+
+    constexpr ByteSet& operator|=(const ByteSet& other) noexcept {
+      for (std::size_t w = 0; w < 4; ++w) {
+        words_[w] |= other.words_[w];
+      }
+      return *this;
+    }
+
+    constexpr ByteSet& operator&=(const ByteSet& other) noexcept {
+      for (std::size_t w = 0; w < 4; ++w) {
+        words_[w] &= other.words_[w];
+      }
+      return *this;
+    }
+
+    constexpr ByteSet& operator-=(const ByteSet& other) noexcept {
+      for (std::size_t w = 0; w < 4; ++w) {
+        words_[w] &= ~other.words_[w];
+      }
+      return *this;
+    }
+
+    // the union of the two sets
+    [[nodiscard]] friend constexpr ByteSet operator|(ByteSet lhs, const ByteSet& rhs) noexcept {
+      return lhs |= rhs;
+    }
+
+    // the intersection of the two sets
+    [[nodiscard]] friend constexpr ByteSet operator&(ByteSet lhs, const ByteSet& rhs) noexcept {
+      return lhs &= rhs;
+    }
+
+    // the members of lhs which aren't members of rhs
+    [[nodiscard]] friend constexpr ByteSet operator-(ByteSet lhs, const ByteSet& rhs) noexcept {
+      return lhs -= rhs;
+    }
+
+    // the bytes which aren't members
+    [[nodiscard]] friend constexpr ByteSet operator~(ByteSet set) noexcept {
+      for (auto& word : set.words_) {
+        word = ~word;
+      }
+      return set;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const ByteSet&,
+                                                   const ByteSet&) noexcept = default;
+  };
+
+  /***
+   * make_byte_set
+   *
+   * Return the set of the bytes of the given string literal, excluding its terminating NUL,
+   * e.g. make_byte_set("\t\n ,;"). It's constexpr, so that the lookup tables of a tokenizer can
+   * be built at compile time instead of during static initialization.
+   * Time: O(N), Space: O(1)
+   */
+  template <std::size_t N>
+  [[nodiscard]] constexpr ByteSet make_byte_set(const char (&bytes)[N]) noexcept {
+    return ByteSet{std::string_view{bytes, N - 1}};
+  }
+
+  /***
+   * byte_range
+   *
+   * Return the set of the bytes in [first, last], e.g. byte_range('a', 'z'), which is empty if
+   * first > last. The words are filled a word at a time, so ranges can be combined with |:
+   * make_byte_set("_") | byte_range('a', 'z') | byte_range('A', 'Z').
+   * Time: O(1), Space: O(1)
+   */
+  [[nodiscard]] constexpr ByteSet byte_range(std::uint8_t first, std::uint8_t last) noexcept {
+    std::array<std::uint64_t, 4> words{};
+    if (first <= last) {
+      for (std::size_t w = 0; w < 4; ++w) {
+        // the bits of the word w within [first, last + 1)
+        const auto lo = std::max<std::size_t>(first, w * 64);
+        const auto hi = std::min<std::size_t>(std::size_t(last) + 1, w * 64 + 64);
+        if (lo < hi) {
+          const auto width = hi - lo;
+          const auto ones = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+          words[w] = ones << (lo - w * 64);
+        }
+      }
+    }
+    return ByteSet{words};
+  }
+}  // namespace jkds::container
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "../util/parallel.h"
+
+namespace jkds::container {
+
+  /***
+   * ConcurrentDisjointSet
+   *
+   * A lock-free Disjoint Set data structure (also known as Union-Find) whose elements are the
+   * dense integer ids [0, size()), and whose methods can be called by many threads at once.
+   *
+   * Every parent pointer is an std::atomic<std::size_t>. Two roots are linked with a single
+   * compare-and-swap, and find compresses paths by path-halving with compare-and-swap as well;
+   * a failed compression is harmless and simply skipped.
+   * Roots are linked by a fixed pseudo-random priority of their index (the randomized linking
+   * by index of Jayanti and Tarjan), so that links never form a cycle and the trees stay shallow
+   * in expectation regardless of the order of the ids.
+   *
+   * The methods are lock-free, not wait-free: no thread ever waits for another one, and a
+   * retry in unite or are_connected only happens because a concurrent unite linked a root,
+   * i.e. because some other thread made progress. A single call can still be delayed for as
+   * long as other threads keep linking the roots it reaches. Note that find, unite and
+   * are_connected all compress paths, so even read-only queries write to the shared parents.
+   *
+   * The number of elements is fixed at construction time.
+   *
+   * Public methods:
+   * - size()
+   * - find(std::size_t)
+   * - unite(std::size_t, std::size_t)
+   * - are_connected(std::size_t, std::size_t)
+   * - unite_batch(std::span<const std::pair<std::size_t, std::size_t>>)
+   * - compress()
+   */
+  class ConcurrentDisjointSet {
+  private:
+    std::size_t size_;
+    std::unique_ptr<std::atomic<std::size_t>[]> parents_;
+
+    // bijective mix of the index: a node is only ever linked below a node with higher priority
+    [[nodiscard]] static std::uint64_t priority(std::size_t i) noexcept {
+      return static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+    }
+
+    [[nodiscard]] std::size_t parent(std::size_t i) const noexcept {
+      return parents_[i].load(std::memory_order_acquire);
+    }
+
+  public:
+    ConcurrentDisjointSet() = delete;
+
+    explicit ConcurrentDisjointSet(std::size_t size) :
+        size_(size), parents_(std::make_unique<std::atomic<std::size_t>[]>(size)) {
+      // initialize every item as the parent of itself
+      for (std::size_t i = 0; i < size_; ++i) {
+        parents_[i].store(i, std::memory_order_relaxed);
+      }
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    /***
+     * find
+     *
+     * Return the current representative of the set containing the element i.
+     * Concurrent unite calls may turn the returned representative into a non-root node.
+     * Lock-free: it takes a hop for every root that concurrent unite calls link above it.
+     * Time: O(lg n) expected, Space: O(1)
+     */
+    [[nodiscard]] std::size_t find(std::size_t i) noexcept {
+      assert(i < size_);
+      auto p = parent(i);
+
+      while (i != p) {
+        const auto grandparent = parent(p);
+
+        // skip parent and point to grandparent, unless another thread got there first
+        if (p != grandparent) {
+          parents_[i].compare_exchange_weak(p, grandparent, std::memory_order_release,
+                                            std::memory_order_relaxed);
+        }
+
+        i = grandparent;
+        p = parent(i);
+      }
+
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Merge the two sets which contain the i and j elements, respectively, into a new set
+     * that is the union of the two sets.
+     * Return true iff this call performed the merge, i.e., iff i and j were in different sets
+     * and no concurrent unite call merged them first.
+     * Lock-free: the link is retried iff a concurrent unite call linked one of the two roots.
+     * Time: O(lg n) expected, Space: O(1)
+     */
+    bool unite(std::size_t i, std::size_t j) noexcept {
+      while (true) {
+        i = find(i);
+        j = find(j);
+
+        if (i == j) {
+          return false;
+        }
+
+        // the root with the lower priority becomes a child of the other one
+        if (priority(i) < priority(j)) {
+          std::swap(i, j);
+        }
+
+        // the link fails iff j is no longer a root, in which case we retry from its new root
+        auto expected = j;
+        if (parents_[j].compare_exchange_strong(expected, i, std::memory_order_acq_rel)) {
+          return true;
+        }
+      }
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * The answer is linearizable with respect to concurrent unite calls.
+     * Lock-free: the check is retried iff a concurrent unite call linked the root of i.
+     * Time: O(lg n) expected, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(std::size_t i, std::size_t j) noexcept {
+      while (true) {
+        i = find(i);
+        j = find(j);
+
+        if (i == j) {
+          return true;
+        }
+
+        // if i is still a root, i and j were in different sets when j's root was found
+        if (parent(i) == i) {
+          return false;
+        }
+      }
+    }
+
+    /***
+     * unite_batch
+     *
+     * Unite the endpoints of every given pair, splitting the pairs into contiguous batches that
+     * are processed by num_threads threads at once.
+     * Return the number of merges performed, i.e., how much the number of sets has decreased.
+     * Time: O(m lg n / num_threads) expected, Space: O(num_threads)
+     */
+    std::size_t unite_batch(std::span<const std::pair<std::size_t, std::size_t>> pairs,
+                            std::size_t num_threads = jkds::util::default_num_threads()) {
+      std::atomic<std::size_t> merges = 0;
+
+      jkds::util::parallel_for(0, pairs.size(), [&](std::size_t first, std::size_t last) {
+        std::size_t local_merges = 0;
+        for (auto k = first; k < last; ++k) {
+          local_merges += unite(pairs[k].first, pairs[k].second);
+        }
+        merges.fetch_add(local_merges, std::memory_order_relaxed);
+      }, num_threads);
+
+      return merges.load();
+    }
+
+    /***
+     * compress
+     *
+     * Point every element directly to its representative, so that subsequent finds take a
+     * single hop. It must not run concurrently with unite.
+     * Time: O(n lg n / num_threads) expected, Space: O(num_threads)
+     */
+    void compress(std::size_t num_threads = jkds::util::default_num_threads()) {
+      jkds::util::parallel_for(0, size_, [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+          parents_[i].store(find(i), std::memory_order_relaxed);
+        }
+      }, num_threads);
+    }
+  };
+}  // namespace jkds::container
@@ -0,0 +1,737 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../functional/fmap.h"
+#include "../util/parallel.h"
+#include "../util/prefetch.h"
+#include "../util/range.h"
+#include "disjoint_set_file.h"
+#include "partition.h"
+
+namespace jkds::container {
+
+  template <typename T>
+  class DisjointSet;
+
+  /***
+   * DenseDisjointSet
+   *
+   * A Disjoint Set data structure (also known as Union-Find) whose elements are the dense
+   * integer ids [0, size()).
+   * Since the elements are already indexes, no hashing is involved: every method operates
+   * directly on the internal std::vector<*> container of nodes.
+   *
+   * DenseDisjointSet implements the union-by-size policy paired with path-splitting compression,
+   * which results in almost constant time complexity for every method.
+   * The size of every set is stored at its representative, and the number of sets is kept up to
+   * date, so both can be queried without snapshotting the sets.
+   * The members of every set are also linked in a circular list, which unite splices in O(1),
+   * so that the members of a single set can be visited in time proportional to its size.
+   * DisjointSet<T> is built on top of DenseDisjointSet.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - add()
+   * - reserve(std::size_t)
+   * - add_range(std::size_t, std::size_t)
+   * - find(std::size_t)
+   * - unite(std::size_t, std::size_t)
+   * - are_connected(std::size_t, std::size_t)
+   * - set_size(std::size_t)
+   * - find_readonly(std::size_t)
+   * - are_connected_readonly(std::size_t, std::size_t)
+   * - freeze()
+   * - get_sets()
+   * - get_partition()
+   * - prefetch(std::size_t)
+   * - members_of(std::size_t)
+   * - compact()
+   * - save(const std::filesystem::path&)
+   * - load(const std::filesystem::path&, bool)
+   * - find_batch(std::span<const std::size_t>, OutputIt)
+   * - are_connected_batch(std::span<const std::pair<std::size_t, std::size_t>>, OutputIt)
+   */
+  class DenseDisjointSet {
+  public:
+    /***
+     * MemberRange
+     *
+     * A lazy forward range over the members of a set, which follows the circular list of the
+     * set starting from a given element. It's invalidated by add and unite.
+     */
+    class MemberRange : public std::ranges::view_interface<MemberRange> {
+    public:
+      class Iterator {
+      private:
+        const std::size_t* next_ = nullptr;
+        std::size_t first_ = 0;
+        std::size_t current_ = 0;
+        bool done_ = true;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(const std::size_t* next, std::size_t first) noexcept :
+            next_(next), first_(first), current_(first), done_(false) {
+        }
+
+        [[nodiscard]] std::size_t operator*() const noexcept {
+          return current_;
+        }
+
+        Iterator& operator++() noexcept {
+          current_ = next_[current_];
+          done_ = current_ == first_;
+          return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+          auto copy = *this;
+          ++*this;
+          return copy;
+        }
+
+        [[nodiscard]] bool operator==(const Iterator& other) const noexcept {
+          return done_ == other.done_ && (done_ || current_ == other.current_);
+        }
+
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept {
+          return done_;
+        }
+      };
+
+    private:
+      const std::size_t* next_ = nullptr;
+      std::size_t first_ = 0;
+
+    public:
+      MemberRange() = default;
+
+      MemberRange(const std::size_t* next, std::size_t first) noexcept :
+          next_(next), first_(first) {
+      }
+
+      [[nodiscard]] Iterator begin() const noexcept {
+        return next_ == nullptr ? Iterator{} : Iterator{next_, first_};
+      }
+
+      [[nodiscard]] std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+      }
+    };
+
+  private:
+    struct Node {
+      std::size_t parent;
+
+      // number of elements in the set, only meaningful for representatives
+      std::size_t size = 1;
+
+      Node(std::size_t parent) : parent(parent) {
+      }
+    };
+    std::vector<Node> nodes_;
+    std::size_t num_sets_;
+
+    // next_[i] is the element after i in the circular list of the members of its set
+    std::vector<std::size_t> next_;
+
+    // return the representative of the set containing the element i, without compressing the path
+    [[nodiscard]] std::size_t find_root(std::size_t i) const noexcept {
+      while (i != nodes_[i].parent) {
+        i = nodes_[i].parent;
+      }
+
+      return i;
+    }
+
+    // number of queries in flight in find_batch and are_connected_batch
+    static constexpr std::size_t batch_window = 16;
+
+    // Find the representatives of the count elements id_of(0), ..., id_of(count - 1), calling
+    // on_root(k, representative) for each of them, in any order.
+    // Up to batch_window finds are interleaved: every step of a find reads a node that was
+    // prefetched by its previous step, so the cache misses of the different finds overlap.
+    // Every step also points the previously visited node to its grandparent, which is the same
+    // path-splitting compression as find.
+    template <typename IdF, typename RootF>
+    void find_pipelined(std::size_t count, IdF id_of, RootF on_root) noexcept {
+      constexpr auto none = static_cast<std::size_t>(-1);
+      struct Slot {
+        std::size_t query;
+        std::size_t previous;
+        std::size_t current;
+      };
+      std::array<Slot, batch_window> slots;
+      std::size_t active = 0;
+      std::size_t next = 0;
+
+      auto start = [&](Slot& slot) {
+        const auto i = id_of(next);
+        assert(i < nodes_.size());
+        jkds::util::prefetch<true>(nodes_.data() + i);
+        slot = {next++, none, i};
+      };
+
+      for (; active < batch_window && next < count; ++active) {
+        start(slots[active]);
+      }
+
+      while (active > 0) {
+        for (std::size_t s = 0; s < active;) {
+          auto& slot = slots[s];
+          const auto parent = nodes_[slot.current].parent;
+
+          if (parent == slot.current) {
+            on_root(slot.query, parent);
+            if (next < count) {
+              start(slot);
+              ++s;
+            } else {
+              // retire the slot, moving the last active one in its place
+              slot = slots[--active];
+            }
+          } else {
+            if (slot.previous != none) {
+              nodes_[slot.previous].parent = parent;
+            }
+            jkds::util::prefetch<true>(nodes_.data() + parent);
+            slot.previous = slot.current;
+            slot.current = parent;
+            ++s;
+          }
+        }
+      }
+    }
+
+    template <typename T>
+    friend class DisjointSet;
+
+    // rebuild a disjoint set from the nodes of a disjoint set file, whose parents are
+    // representatives, and whose representatives store the number of their members
+    DenseDisjointSet(std::span<const detail::DisjointSetFileNode> nodes, std::size_t num_sets) :
+        num_sets_(0), next_(jkds::util::range<std::size_t>(nodes.size())) {
+      // counts[r] is the number of members of the representative r
+      std::vector<std::size_t> counts(nodes.size(), 0);
+      nodes_.reserve(nodes.size());
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const auto parent = nodes[i].parent;
+        if (parent >= nodes.size() || nodes[parent].parent != parent) {
+          throw std::runtime_error("corrupted disjoint set file");
+        }
+        nodes_.emplace_back(parent);
+        nodes_.back().size = nodes[i].size;
+        num_sets_ += parent == i;
+        ++counts[parent];
+      }
+
+      if (num_sets_ != num_sets) {
+        throw std::runtime_error("corrupted disjoint set file");
+      }
+
+      // get_partition, set_size and compact rely on the sizes of the representatives
+      for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].parent == i && nodes_[i].size != counts[i]) {
+          throw std::runtime_error("corrupted disjoint set file");
+        }
+      }
+
+      // splice every element into the circular list of its representative
+      for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        const auto root = nodes_[i].parent;
+        if (i != root) {
+          next_[i] = next_[root];
+          next_[root] = i;
+        }
+      }
+    }
+
+    // append the fully compressed nodes to a disjoint set file
+    void write_nodes(detail::DisjointSetFileWriter& writer) {
+      writer.write_section<detail::DisjointSetFileNode>(
+          nodes_.size(),
+          [this](std::size_t first, std::size_t last, detail::DisjointSetFileNode* block) {
+            for (auto i = first; i < last; ++i) {
+              *block++ = {find(i), nodes_[i].size};
+            }
+          });
+    }
+
+    // initialize every item as the parent of itself with size 1
+    [[nodiscard]] static std::vector<Node> init_nodes(std::size_t size) noexcept {
+      auto parents(jkds::util::range<std::size_t>(size));
+      return jkds::functional::fmap(
+          [](std::size_t parent) {
+            return Node(parent);
+          },
+          parents);
+    }
+
+  public:
+    DenseDisjointSet() = delete;
+
+    explicit DenseDisjointSet(std::size_t size) noexcept :
+        nodes_(init_nodes(size)), num_sets_(size), next_(jkds::util::range<std::size_t>(size)) {
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return nodes_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return num_sets_;
+    }
+
+    /***
+     * add
+     *
+     * Add a new singleton set to the disjoint set, returning the index of the resulting node.
+     * If it throws, nothing is added.
+     * Time: O(1) amortized, Space: O(1)
+     */
+    std::size_t add() {
+      const auto i = nodes_.size();
+      nodes_.emplace_back(i);
+      try {
+        next_.push_back(i);
+      } catch (...) {
+        nodes_.pop_back();
+        throw;
+      }
+      ++num_sets_;
+      return i;
+    }
+
+    /***
+     * reserve
+     *
+     * Reserve the memory for a total of capacity elements, so that adding up to
+     * capacity - size() elements doesn't reallocate.
+     * Time: O(capacity), Space: O(capacity)
+     */
+    void reserve(std::size_t capacity) {
+      nodes_.reserve(capacity);
+      next_.reserve(capacity);
+    }
+
+    /***
+     * add_range
+     *
+     * Add count new singleton sets to the disjoint set, returning the range of their indexes,
+     * i.e. [size() - count, size()) after the call. The nodes are grown once, and initialized
+     * by num_threads threads. If it throws, nothing is added.
+     * Time: O(count / num_threads) amortized, Space: O(count)
+     */
+    std::ranges::iota_view<std::size_t, std::size_t> add_range(std::size_t count,
+                                                               std::size_t num_threads = 1) {
+      const auto first = nodes_.size();
+      const auto last = first + count;
+      try {
+        nodes_.resize(last, Node(0));
+        next_.resize(last);
+
+        jkds::util::parallel_for(first, last, [this](std::size_t from, std::size_t to) {
+          for (auto i = from; i < to; ++i) {
+            nodes_[i].parent = i;
+            next_[i] = i;
+          }
+        }, num_threads);
+      } catch (...) {
+        nodes_.resize(first, Node(0));
+        next_.resize(first);
+        throw;
+      }
+
+      num_sets_ += count;
+      return std::views::iota(first, last);
+    }
+
+    /***
+     * find
+     *
+     * Return the representative of the set containing the element i.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] std::size_t find(std::size_t i) noexcept {
+      assert(i < nodes_.size());
+
+      while (i != nodes_[i].parent) {
+        // skip parent and point to grandparent
+        const auto grandparent = nodes_[nodes_[i].parent].parent;
+        nodes_[i].parent = grandparent;
+        i = grandparent;
+      }
+
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Merge the two sets which contain the i and j elements, respectively, into a new set
+     * that is the union of the two sets.
+     * Return true iff i and j were in different sets before the call.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    bool unite(std::size_t i, std::size_t j) noexcept {
+      i = find(i);
+      j = find(j);
+
+      if (i == j) {
+        return false;
+      }
+
+      // the representative of the smaller set points to the representative of the larger one
+      if (nodes_[i].size < nodes_[j].size) {
+        std::swap(i, j);
+      }
+
+      nodes_[j].parent = i;
+      nodes_[i].size += nodes_[j].size;
+      --num_sets_;
+
+      // swapping the successors of two elements of different circular lists splices them
+      std::swap(next_[i], next_[j]);
+
+      return true;
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(std::size_t i, std::size_t j) noexcept {
+      return find(i) == find(j);
+    }
+
+    /***
+     * set_size
+     *
+     * Return the number of elements in the set containing the element i.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] std::size_t set_size(std::size_t i) noexcept {
+      return nodes_[find(i)].size;
+    }
+
+    /***
+     * find_readonly
+     *
+     * Return the representative of the set containing the element i, like find, but without
+     * compressing the path. Since nothing is written, any number of threads can call the
+     * readonly methods concurrently, as long as no thread modifies the disjoint set.
+     * After freeze, the path of every element is a single hop.
+     * Time: O(lg n), or O(1) after freeze, Space: O(1)
+     */
+    [[nodiscard]] std::size_t find_readonly(std::size_t i) const noexcept {
+      assert(i < nodes_.size());
+      return find_root(i);
+    }
+
+    /***
+     * are_connected_readonly
+     *
+     * Return true if and only if the given two elements are in the same representative set,
+     * without compressing any path (see find_readonly).
+     * Time: O(lg n), or O(1) after freeze, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected_readonly(std::size_t i, std::size_t j) const noexcept {
+      return find_root(i) == find_root(j);
+    }
+
+    /***
+     * freeze
+     *
+     * Fully compress every path, pointing every element directly to its representative, so
+     * that the following readonly finds are a single hop, until the next unite.
+     * Unlike compact, the elements aren't renumbered.
+     * Time: O(n lg^* n), Space: O(1)
+     */
+    void freeze() noexcept {
+      for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        nodes_[i].parent = find(i);
+      }
+    }
+
+    /***
+     * members_of
+     *
+     * Return a lazy range over the members of the set containing the element i, starting
+     * from i itself. Iterating it visits exactly the members of the set, without any find.
+     * The range is invalidated by add and unite.
+     * Time: O(1) to create, O(|set|) to iterate, Space: O(1)
+     */
+    [[nodiscard]] MemberRange members_of(std::size_t i) const noexcept {
+      assert(i < nodes_.size());
+      return MemberRange(next_.data(), i);
+    }
+
+    /***
+     * compact
+     *
+     * Renumber the elements so that the members of every set are contiguous, with their
+     * representative first, and every element points directly to its representative.
+     * Sets are ordered by their smallest element, and the other members of every set keep
+     * their relative order. Return the permutation applied, where the element formerly known
+     * as i is now permutation[i], so that callers can reorder their own side arrays.
+     * After compact, find never follows more than one parent, and the nodes visited by the
+     * finds over the members of a set share a few cache lines.
+     * Every buffer is allocated before the nodes are renumbered, so if it throws, the elements
+     * keep their numbers.
+     * Time: O(n lg^* n), Space: O(n)
+     */
+    std::vector<std::size_t> compact() {
+      const auto n = nodes_.size();
+      std::vector<std::size_t> roots(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        roots[i] = find(i);
+      }
+
+      // cursors[r] is the next free position in the group of the representative r
+      constexpr auto unassigned = static_cast<std::size_t>(-1);
+      std::vector<std::size_t> cursors(n, unassigned);
+      std::vector<std::size_t> permutation(n);
+      std::size_t next_group = 0;
+
+      for (std::size_t i = 0; i < n; ++i) {
+        const auto root = roots[i];
+        if (cursors[root] == unassigned) {
+          permutation[root] = next_group;
+          cursors[root] = next_group + 1;
+          next_group += nodes_[root].size;
+        }
+        if (i != root) {
+          permutation[i] = cursors[root]++;
+        }
+      }
+
+      std::vector<Node> nodes(n, Node(0));
+      for (std::size_t i = 0; i < n; ++i) {
+        auto& node = nodes[permutation[i]];
+        node.parent = permutation[roots[i]];
+        node.size = nodes_[i].size;
+      }
+
+      // the circular list of every group visits its members in order
+      for (std::size_t k = 0; k < n; ++k) {
+        const auto first = nodes[k].parent;
+        next_[k] = k + 1 < first + nodes[first].size ? k + 1 : first;
+      }
+
+      nodes_ = std::move(nodes);
+      return permutation;
+    }
+
+    /***
+     * save
+     *
+     * Write the disjoint set to a binary file at the given path, fully compressing every path.
+     * The file has a versioned header and a checksum; it can be read back by load, or mapped
+     * in memory and queried right away by MappedDenseDisjointSet.
+     * Throw std::runtime_error if the file can't be written.
+     * Time: O(n lg^* n), Space: O(1)
+     */
+    void save(const std::filesystem::path& path) {
+      detail::DisjointSetFileWriter writer{path};
+      write_nodes(writer);
+
+      detail::DisjointSetFileHeader header{};
+      header.size = nodes_.size();
+      header.num_sets = num_sets_;
+      writer.finish(header);
+    }
+
+    /***
+     * load
+     *
+     * Read a disjoint set from a binary file written by save (or by DisjointSet<T>::save, whose
+     * keys are ignored). If verify is true, the checksum is verified too.
+     * Throw std::runtime_error if the file can't be read, or it's corrupted.
+     * Time: O(n), Space: O(n)
+     */
+    [[nodiscard]] static DenseDisjointSet load(const std::filesystem::path& path,
+                                               bool verify = true) {
+      const auto words = detail::read_disjoint_set_file(path);
+      const auto data = reinterpret_cast<const std::byte*>(words.data());
+      const auto header =
+          detail::check_disjoint_set_file(data, words.size() * sizeof(std::uint64_t), verify);
+
+      return DenseDisjointSet(
+          std::span<const detail::DisjointSetFileNode>(
+              reinterpret_cast<const detail::DisjointSetFileNode*>(
+                  data + sizeof(detail::DisjointSetFileHeader)),
+              header.size),
+          header.num_sets);
+    }
+
+    /***
+     * get_sets
+     *
+     * Snapshot the representative sets.
+     * Time: O(n lg^* n), Space: O(n)
+     */
+    [[nodiscard]] auto get_sets() noexcept {
+      std::unordered_map<std::size_t, std::vector<std::size_t>> sets;
+      for (std::size_t i = 0; i < nodes_.size(); ++i) {
+        sets[find(i)].emplace_back(i);
+      }
+      return sets;
+    }
+
+    /***
+     * get_partition
+     *
+     * Snapshot the representative sets as a Partition, i.e. in the CSR format, mapping every
+     * element i to proj(i). Sets are ordered by their smallest element, and the members of
+     * every set are sorted.
+     * The representatives are relabeled with dense group ids in a first linear pass, and the
+     * members are scattered into their groups in a second linear pass; only the first pass,
+     * which finds the representatives, may be split among num_threads threads.
+     * Time: O(n lg^* n / num_threads + n), Space: O(n)
+     */
+    template <typename Projection = std::identity>
+    [[nodiscard]] auto get_partition(std::size_t num_threads = 1, Projection proj = {}) {
+      using value_t = std::decay_t<std::invoke_result_t<Projection&, std::size_t>>;
+      const auto n = nodes_.size();
+
+      // groups[i] is initially the representative of i
+      std::vector<std::size_t> groups(n);
+      if (num_threads > 1) {
+        jkds::util::parallel_for(0, n, [&](std::size_t first, std::size_t last) {
+          for (auto i = first; i < last; ++i) {
+            groups[i] = find_root(i);
+          }
+        }, num_threads);
+      } else {
+        for (std::size_t i = 0; i < n; ++i) {
+          groups[i] = find(i);
+        }
+      }
+
+      // first pass: relabel the representatives with dense group ids, and size the groups.
+      // labels[r] is the group id of the representative r
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+      std::vector<std::size_t> labels(n, unlabeled);
+      std::vector<std::size_t> offsets(num_sets_ + 1, 0);
+      std::size_t next_label = 0;
+
+      for (std::size_t i = 0; i < n; ++i) {
+        const auto root = groups[i];
+        if (labels[root] == unlabeled) {
+          labels[root] = next_label;
+          offsets[++next_label] = nodes_[root].size;
+        }
+        groups[i] = labels[root];
+      }
+
+      for (std::size_t g = 0; g < next_label; ++g) {
+        offsets[g + 1] += offsets[g];
+      }
+
+      // second pass: scatter the members into their groups, using labels as cursors
+      std::copy(offsets.begin(), offsets.end() - 1, labels.begin());
+      std::vector<std::size_t> members(n);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        members[labels[groups[i]]++] = i;
+      }
+
+      if constexpr (std::is_same_v<Projection, std::identity>) {
+        return Partition<value_t>(std::move(offsets), std::move(members));
+      } else {
+        return Partition<value_t>(std::move(offsets), jkds::functional::fmap(proj, members));
+      }
+    }
+
+    /***
+     * prefetch
+     *
+     * Hint the processor to load the node of the element i into the cache, so that a later
+     * find(i) doesn't stall on it. Elements out of range are ignored.
+     * Time: O(1), Space: O(1)
+     */
+    void prefetch(std::size_t i) const noexcept {
+      if (i < nodes_.size()) {
+        jkds::util::prefetch<true>(nodes_.data() + i);
+      }
+    }
+
+    /***
+     * find_batch
+     *
+     * Write the representative of the set containing ids[k] to out[k], for every k, where out
+     * is a random access iterator.
+     * The finds are software-pipelined: up to 16 of them are in flight at once, and each one
+     * prefetches the next node on its path while the others proceed, so that their cache
+     * misses overlap instead of stalling one after the other. On instances that don't fit in
+     * the cache, this gives several times the throughput of a loop over find.
+     * Time: O(m lg^* n) amortized, Space: O(1)
+     */
+    template <typename OutputIt>
+    void find_batch(std::span<const std::size_t> ids, OutputIt out) noexcept {
+      find_pipelined(
+          ids.size(),
+          [&](std::size_t k) {
+            return ids[k];
+          },
+          [&](std::size_t k, std::size_t root) {
+            out[k] = root;
+          });
+    }
+
+    /***
+     * are_connected_batch
+     *
+     * Write are_connected(pairs[k].first, pairs[k].second) to out[k], for every k, where out
+     * is a random access iterator. The finds are software-pipelined as in find_batch.
+     * Time: O(m lg^* n) amortized, Space: O(1)
+     */
+    template <typename OutputIt>
+    void are_connected_batch(std::span<const std::pair<std::size_t, std::size_t>> pairs,
+                             OutputIt out) noexcept {
+      // the representatives are buffered a block of pairs at a time
+      constexpr std::size_t block = 1024;
+      std::array<std::size_t, 2 * block> roots;
+
+      for (std::size_t first = 0; first < pairs.size(); first += block) {
+        const auto count = std::min(block, pairs.size() - first);
+        find_pipelined(
+            2 * count,
+            [&](std::size_t k) {
+              const auto& pair = pairs[first + k / 2];
+              return k % 2 == 0 ? pair.first : pair.second;
+            },
+            [&](std::size_t k, std::size_t root) {
+              roots[k] = root;
+            });
+
+        for (std::size_t k = 0; k < count; ++k) {
+          out[first + k] = roots[2 * k] == roots[2 * k + 1];
+        }
+      }
+    }
+  };
+}  // namespace jkds::container
@@ -1,13 +1,27 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include "../functional/fmap.h"
-#include "../functional/zip.h"
 #include "../util/range.h"
+#include "dense_disjoint_set.h"
+#include "disjoint_set_file.h"
+#include "keyed_index.h"
+#include "partition.h"
 
 namespace jkds::container {
 
@@ -19,123 +33,160 @@ namespace jkds::container {
    * The simplest implementations only support integer elements. However, we support any type of elements;
    * the elements are mapped to an std::size_t index internally. 
    * 
-   * The internal elements are stored in a std::vector<*> container, and the mapping between
-   * elements an their indexes in the vector are stored in a std::unordered_map<T, std::size_t> container.
-   * Hence, an implementation of std::hash<T> is required.
+   * Every element is stored once, as a key of the std::unordered_map<T, std::size_t> that maps
+   * it to its index, and the reverse mapping is a std::vector of pointers to those keys, which
+   * stay put when the map rehashes (see detail::KeyedIndex). Hence, an implementation of
+   * std::hash<T> is required.
    * 
-   * DisjointSet is optimized, as it implements the union-by-rank policy paired with path-splitting compression,
+   * DisjointSet is optimized, as it implements the union-by-size policy paired with path-splitting compression,
    * which results in almost constant time complexity for every method. 
+   * The size of every set and the number of sets are kept up to date during unite.
+   * If the elements are already dense integer ids, prefer DenseDisjointSet, which skips the
+   * hash lookups altogether.
    * 
    * Public methods:
+   * - size()
+   * - num_sets()
    * - add(const T&)
+   * - reserve(std::size_t)
+   * - add_range(It, Sentinel)
+   * - contains(const T&)
    * - unite(const T&, const T&)
    * - are_connected(const T&, const T&)
+   * - set_size(const T&)
+   * - are_connected_readonly(const T&, const T&)
+   * - freeze()
+   * - members_of(const T&)
+   * - compact()
+   * - save(const std::filesystem::path&)
+   * - load(const std::filesystem::path&, bool)
    * - get_sets()
+   * - get_partition()
+   * - are_connected_batch(std::span<const std::pair<T, T>>, OutputIt)
    */
   template <typename T>
   class DisjointSet {
   private:
-    struct Node {
-      std::size_t parent;
-      std::size_t rank = 0;
+    detail::KeyedIndex<T> index_;
 
-      Node(std::size_t parent) : parent(parent) {
-      }
-    };
-    std::vector<Node> nodes_;
-    std::unordered_map<T, std::size_t> index_map_;
-
-    // initialize every item as the parent of itself with rank 0
-    [[nodiscard]] static std::vector<Node> init_nodes(std::size_t size) noexcept {
-      auto parents(jkds::util::range<std::size_t>(size));
-      return jkds::functional::fmap(
-          [](std::size_t parent) {
-            return Node(parent);
-          },
-          parents);
-    }
-
-    // initialize the index map in sequential order, starting from 0
-    template <typename V>
-    [[nodiscard]] static std::unordered_map<V, std::size_t> init_index_map(
-        std::vector<V>&& inputs) noexcept {
-      const auto size = inputs.size();
-      std::unordered_map<V, std::size_t> index_map;
-      index_map.reserve(size);
-
-      for (auto&& [x, i] : jkds::functional::zip(inputs, jkds::util::range<std::size_t>(size))) {
-        index_map.emplace(x, i);
-      }
-
-      return index_map;
-    }
-
-    // Returns of the representative set containing the element indexed by the given index
-    [[nodiscard]] std::size_t find(std::size_t index) noexcept {
-      while (index != nodes_[index].parent) {
-        // skip parent and point to grandparent
-        const auto grandparent = nodes_[nodes_[index].parent].parent;
-        nodes_[index].parent = grandparent;
-        index = grandparent;
-      }
+    // the nodes are declared after the keys, which size them
+    DenseDisjointSet sets_;
 
-      return index;
+    // the index must have as many elements as the nodes
+    DisjointSet(DenseDisjointSet&& sets, detail::KeyedIndex<T>&& index) :
+        index_(std::move(index)), sets_(std::move(sets)) {
+      assert(index_.size() == sets_.size());
     }
 
   public:
     DisjointSet() = delete;
 
+    // a repeated input is added only once, at the position of its first occurrence
     explicit DisjointSet(const std::vector<T>& inputs) noexcept :
-        nodes_(init_nodes(inputs.size())), index_map_(init_index_map(inputs)) {
+        index_(inputs.begin(), inputs.end()), sets_(index_.size()) {
     }
 
+    // the inputs are moved into the index map
     explicit DisjointSet(std::vector<T>&& inputs) noexcept :
-        nodes_(init_nodes(inputs.size())), index_map_(init_index_map(std::move(inputs))) {
+        index_(std::make_move_iterator(inputs.begin()), std::make_move_iterator(inputs.end())),
+        sets_(index_.size()) {
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return sets_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return sets_.num_sets();
     }
 
     /***
      * add
      * 
      * Add a new entry to the disjoint set, returning the index of the resulting node.
+     * Throw std::invalid_argument if x is already an element. If it throws, nothing is added.
      * Time: O(1) amortized, Space: O(1)
      */
     std::size_t add(const T& x) {
-      const auto i = nodes_.size();
-      nodes_.emplace_back(i);
-      const auto&& [it, ok] = index_map_.emplace(x, i);
-      assert(ok);
-      return it->second;
+      const auto i = index_.add(x);
+      try {
+        sets_.add();
+      } catch (...) {
+        index_.pop_back();
+        throw;
+      }
+      return i;
     }
 
     /***
-     * unite
-     * 
-     * Merge two dynamic sets which contain the x and y elements, respectively, into a new set
-     * that is the union of the two sets.
-     * x is assumed to be different than y.
-     * Time: O(lg^* n) amortized, Space: O(1) 
+     * reserve
+     *
+     * Reserve the memory for a total of capacity elements, in both the nodes and the index
+     * map, so that adding up to capacity - size() elements neither reallocates nor rehashes.
+     * Time: O(capacity), Space: O(capacity)
      */
-    void unite(const T& x, const T& y) noexcept {
-      auto i = find(index_map_.at(x));
-      auto j = find(index_map_.at(y));
+    void reserve(std::size_t capacity) {
+      sets_.reserve(capacity);
+      index_.reserve(capacity);
+    }
 
-      if (i == j) {
-        return;
+    /***
+     * add_range
+     *
+     * Add the elements of [first, last) to the disjoint set, each as a new singleton set, and
+     * return the range of their indexes, i.e. [size() - count, size()) after the call.
+     * If the iterators are forward iterators, the memory is reserved upfront, so that the
+     * whole range is added with at most one reallocation and one rehash. The capacity grows
+     * geometrically, so that streaming many small ranges is still amortized O(1) per element.
+     * Throw std::invalid_argument if an element is repeated, or is already an element. If it
+     * throws, either for that reason or because of the iterators or the copies of T, nothing
+     * is added.
+     * Time: O(count) on average, Space: O(count)
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sentinel>
+    std::ranges::iota_view<std::size_t, std::size_t> add_range(It first, Sentinel last) {
+      const auto first_index = index_.size();
+      if constexpr (std::forward_iterator<It>) {
+        const auto count = static_cast<std::size_t>(std::ranges::distance(first, last));
+        if (first_index + count > index_.capacity()) {
+          reserve(std::max(first_index + count, 2 * index_.capacity()));
+        }
       }
 
-      // if two sets are united and have different ranks,
-      // the resulting set's rank is the larger of the two
-      if (nodes_[i].rank < nodes_[j].rank) {
-        std::swap(i, j);
+      try {
+        for (; first != last; ++first) {
+          index_.add(*first);
+        }
+
+        return sets_.add_range(index_.size() - first_index);
+      } catch (...) {
+        index_.truncate(first_index);
+        throw;
       }
+    }
 
-      nodes_[j].parent = i;
+    /***
+     * contains
+     *
+     * Return true iff x is an element of the disjoint set.
+     * Time: O(1) on average, Space: O(1)
+     */
+    [[nodiscard]] bool contains(const T& x) const {
+      return index_.contains(x);
+    }
 
-      // if two sets are united and have the same rank,
-      // the resulting representative set's rank is one unit larger
-      if (nodes_[i].rank == nodes_[j].rank) {
-        ++(nodes_[j].rank);
-      }
+    /***
+     * unite
+     * 
+     * Merge two dynamic sets which contain the x and y elements, respectively, into a new set
+     * that is the union of the two sets.
+     * Return true iff x and y were in different sets before the call.
+     * Time: O(lg^* n) amortized, Space: O(1) 
+     */
+    bool unite(const T& x, const T& y) noexcept {
+      return sets_.unite(index_.at(x), index_.at(y));
     }
 
     /***
@@ -145,7 +196,168 @@ namespace jkds::container {
      * Time: O(lg^* n) amortized, Space: O(1) 
      */
     [[nodiscard]] bool are_connected(const T& x, const T& y) noexcept {
-      return find(index_map_.at(x)) == find(index_map_.at(y));
+      return sets_.are_connected(index_.at(x), index_.at(y));
+    }
+
+    /***
+     * set_size
+     * 
+     * Return the number of elements in the set containing x.
+     * Time: O(lg^* n) amortized, Space: O(1) 
+     */
+    [[nodiscard]] std::size_t set_size(const T& x) noexcept {
+      return sets_.set_size(index_.at(x));
+    }
+
+    /***
+     * are_connected_readonly
+     *
+     * Return true if and only if the given two elements are in the same representative set,
+     * without compressing any path (see DenseDisjointSet::find_readonly). Since nothing is
+     * written, any number of threads can call it concurrently, as long as no thread modifies
+     * the disjoint set.
+     * Time: O(lg n), or O(1) after freeze, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected_readonly(const T& x, const T& y) const {
+      return sets_.are_connected_readonly(index_.at(x), index_.at(y));
+    }
+
+    /***
+     * freeze
+     *
+     * Fully compress every path, so that the following readonly queries are a single hop,
+     * until the next unite.
+     * Time: O(n lg^* n), Space: O(1)
+     */
+    void freeze() noexcept {
+      sets_.freeze();
+    }
+
+    /***
+     * members_of
+     *
+     * Return a lazy range over the members of the set containing x, starting from x itself,
+     * which follows the circular member list maintained by DenseDisjointSet.
+     * The range is invalidated by add and unite.
+     * Time: O(1) to create, O(|set|) to iterate, Space: O(1)
+     */
+    [[nodiscard]] auto members_of(const T& x) const {
+      return sets_.members_of(index_.at(x)) |
+             std::views::transform([this](std::size_t i) -> const T& {
+               return index_.key(i);
+             });
+    }
+
+    /***
+     * compact
+     *
+     * Renumber the internal indexes so that the members of every set are contiguous, with
+     * their representative first, and fully compress every path (see
+     * DenseDisjointSet::compact). Return the permutation applied to the indexes, where the
+     * element whose index was i (the i-th added element) now has index permutation[i].
+     * Time: O(n lg^* n), Space: O(n)
+     */
+    std::vector<std::size_t> compact() {
+      // the keys are renumbered without allocating once the nodes are, so that a throw can't
+      // leave them numbered differently
+      auto keys = index_.prepare_permute();
+      auto permutation = sets_.compact();
+      index_.permute(permutation, std::move(keys));
+      return permutation;
+    }
+
+    /***
+     * save
+     *
+     * Write the disjoint set to a binary file at the given path, fully compressing every path.
+     * Besides the nodes written by DenseDisjointSet::save, the file stores the keys in sorted
+     * order, with their indexes, so that it can be read back by load, or mapped in memory and
+     * queried right away by MappedDisjointSet<T>.
+     * Only trivially copyable and totally ordered keys are supported, which is checked at
+     * compile time: the keys are copied bytewise to the file.
+     * Throw std::runtime_error if the file can't be written.
+     * Time: O(n lg n), Space: O(n)
+     */
+    void save(const std::filesystem::path& path)
+    requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+    {
+      auto order = jkds::util::range<std::size_t>(index_.size());
+      std::sort(order.begin(), order.end(), [this](std::size_t i, std::size_t j) {
+        return index_.key(i) < index_.key(j);
+      });
+
+      detail::DisjointSetFileWriter writer{path};
+      sets_.write_nodes(writer);
+
+      detail::DisjointSetFileHeader header{};
+      header.size = index_.size();
+      header.num_sets = sets_.num_sets();
+      header.key_size = sizeof(T);
+      header.keys_offset = writer.write_section<T>(
+          index_.size(), [&](std::size_t first, std::size_t last, T* block) {
+            for (auto k = first; k < last; ++k) {
+              std::memcpy(block++, &index_.key(order[k]), sizeof(T));
+            }
+          });
+      header.indexes_offset = writer.write_section<std::uint64_t>(
+          index_.size(), [&](std::size_t first, std::size_t last, std::uint64_t* block) {
+            for (auto k = first; k < last; ++k) {
+              *block++ = order[k];
+            }
+          });
+      writer.finish(header);
+    }
+
+    /***
+     * load
+     *
+     * Read a disjoint set from a binary file written by save. If verify is true, the checksum
+     * is verified too.
+     * As with save, T must be trivially copyable and totally ordered, which is checked at
+     * compile time: the keys are copied bytewise out of the file.
+     * Throw std::runtime_error if the file can't be read, it's corrupted, or its keys have a
+     * different size than T. Repeated keys or indexes are always caught.
+     * Time: O(n), Space: O(n)
+     */
+    [[nodiscard]] static DisjointSet load(const std::filesystem::path& path, bool verify = true)
+    requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+    {
+      const auto words = detail::read_disjoint_set_file(path);
+      const auto data = reinterpret_cast<const std::byte*>(words.data());
+      const auto header =
+          detail::check_disjoint_set_file(data, words.size() * sizeof(std::uint64_t), verify);
+      if (header.key_size != sizeof(T)) {
+        throw std::runtime_error("disjoint set file with keys of a different type");
+      }
+
+      DenseDisjointSet sets{std::span<const detail::DisjointSetFileNode>(
+                                reinterpret_cast<const detail::DisjointSetFileNode*>(
+                                    data + sizeof(detail::DisjointSetFileHeader)),
+                                header.size),
+                            header.num_sets};
+
+      // the indexes must be a permutation of [0, size), and the keys must be distinct, even if
+      // the checksum isn't verified
+      std::unordered_map<T, std::size_t> index_map;
+      index_map.reserve(header.size);
+      std::vector<bool> seen(header.size);
+      const auto indexes = reinterpret_cast<const std::uint64_t*>(data + header.indexes_offset);
+      for (std::size_t k = 0; k < header.size; ++k) {
+        if (indexes[k] >= header.size || seen[indexes[k]]) {
+          throw std::runtime_error("corrupted disjoint set file");
+        }
+        seen[indexes[k]] = true;
+
+        // the key is copied out of the file as a whole object, so T needn't be default
+        // constructible
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), data + header.keys_offset + k * sizeof(T), sizeof(T));
+        if (!index_map.emplace(std::bit_cast<T>(bytes), indexes[k]).second) {
+          throw std::runtime_error("corrupted disjoint set file");
+        }
+      }
+
+      return DisjointSet(std::move(sets), detail::KeyedIndex<T>(std::move(index_map)));
     }
 
     /***
@@ -156,10 +368,45 @@ namespace jkds::container {
      */
     [[nodiscard]] auto get_sets() noexcept {
       std::unordered_map<std::size_t, std::vector<T>> sets;
-      for (auto&& [x, index] : index_map_) {
-        sets[find(index)].emplace_back(x);
+      for (auto&& [x, index] : index_) {
+        sets[sets_.find(index)].emplace_back(x);
       }
       return sets;
     }
+
+    /***
+     * get_partition
+     * 
+     * Snapshot the representative sets as a Partition, i.e. in the CSR format.
+     * Sets are ordered by their first added element, and the members of every set are sorted
+     * by insertion order (or by their index, after compact). The lookup of the representatives
+     * may be split among num_threads threads.
+     * Time: O(n lg^* n / num_threads + n), Space: O(n)
+     */
+    [[nodiscard]] Partition<T> get_partition(std::size_t num_threads = 1) {
+      return sets_.get_partition(num_threads, [this](std::size_t i) {
+        return index_.key(i);
+      });
+    }
+
+    /***
+     * are_connected_batch
+     *
+     * Write are_connected(pairs[k].first, pairs[k].second) to out[k], for every k, where out
+     * is a random access iterator. The elements are mapped to their indexes first, then the
+     * finds are software-pipelined by DenseDisjointSet::are_connected_batch.
+     * Time: O(m lg^* n) amortized, Space: O(m)
+     */
+    template <typename OutputIt>
+    void are_connected_batch(std::span<const std::pair<T, T>> pairs, OutputIt out) {
+      std::vector<std::pair<std::size_t, std::size_t>> indexes;
+      indexes.reserve(pairs.size());
+
+      for (auto&& [x, y] : pairs) {
+        indexes.emplace_back(index_.at(x), index_.at(y));
+      }
+
+      sets_.are_connected_batch(indexes, out);
+    }
   };
 }  // namespace jkds::container
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace jkds::container::detail {
+
+  /***
+   * The binary file format shared by DenseDisjointSet::save, DisjointSet<T>::save and the
+   * mapped disjoint sets. Every number is stored in the native byte order, and every section
+   * starts at a multiple of 64 bytes:
+   * - a 64-byte DisjointSetFileHeader;
+   * - the nodes, as size pairs of (parent, set size), where every parent is a representative;
+   * - only if key_size > 0, the keys sorted in increasing order, as size arrays of key_size
+   *   bytes, followed by the index of every sorted key, as size 64-bit integers.
+   * The checksum is the 64-bit FNV-1a hash of every 8-byte word after the header.
+   */
+  constexpr std::array<char, 8> disjoint_set_file_magic{'J', 'K', 'D', 'S', 'U', 'F', 'F', 0};
+  constexpr std::uint32_t disjoint_set_file_version = 1;
+  constexpr std::uint32_t disjoint_set_file_byte_order = 0x01020304;
+  constexpr std::size_t disjoint_set_file_alignment = 64;
+
+  struct DisjointSetFileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t size;
+    std::uint64_t num_sets;
+    std::uint64_t key_size;
+    std::uint64_t keys_offset;
+    std::uint64_t indexes_offset;
+    std::uint64_t checksum;
+  };
+  static_assert(sizeof(DisjointSetFileHeader) == disjoint_set_file_alignment);
+
+  struct DisjointSetFileNode {
+    std::uint64_t parent;
+    std::uint64_t size;
+  };
+
+  [[nodiscard]] constexpr std::uint64_t align_file_offset(std::uint64_t offset) noexcept {
+    return (offset + disjoint_set_file_alignment - 1) / disjoint_set_file_alignment *
+           disjoint_set_file_alignment;
+  }
+
+  // fold the given 8-byte words into a 64-bit FNV-1a hash
+  [[nodiscard]] inline std::uint64_t fnv1a_words(std::span<const std::uint64_t> words,
+                                                 std::uint64_t hash = 0xcbf29ce484222325) {
+    for (auto word : words) {
+      hash = (hash ^ word) * 0x100000001b3;
+    }
+    return hash;
+  }
+
+  // Writes a disjoint set file section by section, padding every section to the alignment
+  // and hashing everything but the header.
+  class DisjointSetFileWriter {
+  private:
+    std::filesystem::path path_;
+    std::ofstream out_;
+    std::uint64_t offset_ = sizeof(DisjointSetFileHeader);
+    std::uint64_t checksum_ = fnv1a_words({});
+
+  public:
+    explicit DisjointSetFileWriter(const std::filesystem::path& path) :
+        path_(path), out_(path, std::ios::binary | std::ios::trunc) {
+      if (!out_) {
+        throw std::runtime_error("cannot open " + path.string());
+      }
+
+      // the header is written last, when the checksum is known
+      const std::array<char, sizeof(DisjointSetFileHeader)> placeholder{};
+      out_.write(placeholder.data(), placeholder.size());
+    }
+
+    [[nodiscard]] std::uint64_t offset() const noexcept {
+      return offset_;
+    }
+
+    // append a section made of the given trivially copyable items, written a block at a time
+    // by fill(first, last, block), and return its offset
+    template <typename Item, typename Fill>
+    std::uint64_t write_section(std::size_t count, Fill fill) {
+      const auto section_offset = offset_;
+      // a multiple of 8 items, so that only the last block may end in the middle of a word
+      constexpr std::size_t block_items = std::size_t(1) << 16;
+      std::vector<std::uint64_t> words;
+
+      for (std::size_t first = 0; first < count; first += block_items) {
+        const auto last = std::min(count, first + block_items);
+        const auto bytes = (last - first) * sizeof(Item);
+
+        // the block is padded with zeros to a whole number of words
+        words.assign((bytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t), 0);
+        fill(first, last, reinterpret_cast<Item*>(words.data()));
+
+        out_.write(reinterpret_cast<const char*>(words.data()),
+                   std::streamsize(words.size() * sizeof(std::uint64_t)));
+        checksum_ = fnv1a_words(words, checksum_);
+        offset_ += words.size() * sizeof(std::uint64_t);
+      }
+
+      pad();
+      return section_offset;
+    }
+
+    // pad the file with zeros to the next alignment boundary
+    void pad() {
+      const auto padding = align_file_offset(offset_) - offset_;
+      const std::array<char, disjoint_set_file_alignment> zeros{};
+      out_.write(zeros.data(), std::streamsize(padding));
+      checksum_ = fnv1a_words(std::vector<std::uint64_t>(padding / sizeof(std::uint64_t)),
+                              checksum_);
+      offset_ += padding;
+    }
+
+    // write the header with the checksum of every section, and close the file
+    void finish(DisjointSetFileHeader header) {
+      header.magic = disjoint_set_file_magic;
+      header.version = disjoint_set_file_version;
+      header.byte_order = disjoint_set_file_byte_order;
+      header.checksum = checksum_;
+
+      out_.seekp(0);
+      out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out_.close();
+      if (!out_) {
+        throw std::runtime_error("cannot write " + path_.string());
+      }
+    }
+  };
+
+  // Validate the header of a disjoint set file of the given size, whose bytes start at data,
+  // and return it. If verify is true, the checksum is verified as well, reading every byte.
+  // Throw std::runtime_error on any mismatch.
+  inline DisjointSetFileHeader check_disjoint_set_file(const std::byte* data, std::size_t bytes,
+                                                       bool verify) {
+    DisjointSetFileHeader header;
+    if (bytes < sizeof(header)) {
+      throw std::runtime_error("disjoint set file too short");
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if (header.magic != disjoint_set_file_magic) {
+      throw std::runtime_error("not a disjoint set file");
+    }
+    if (header.version != disjoint_set_file_version) {
+      throw std::runtime_error("unsupported disjoint set file version");
+    }
+    if (header.byte_order != disjoint_set_file_byte_order) {
+      throw std::runtime_error("disjoint set file with a different byte order");
+    }
+
+    // bound every factor and offset by the file size first, so that the sections' ends can't
+    // overflow and wrap around to a size that looks valid
+    if (header.size > (bytes - sizeof(header)) / sizeof(DisjointSetFileNode) ||
+        (header.key_size != 0 &&
+         (header.size > bytes / header.key_size || header.keys_offset > bytes ||
+          header.indexes_offset > bytes))) {
+      throw std::runtime_error("corrupted disjoint set file");
+    }
+
+    // the keys and the indexes are accessed in place, so their sections must be aligned
+    if (header.key_size != 0 && (header.keys_offset % disjoint_set_file_alignment != 0 ||
+                                 header.indexes_offset % disjoint_set_file_alignment != 0)) {
+      throw std::runtime_error("corrupted disjoint set file");
+    }
+
+    const auto nodes_end = sizeof(header) + header.size * sizeof(DisjointSetFileNode);
+    const auto end = header.key_size == 0
+                         ? align_file_offset(nodes_end)
+                         : align_file_offset(header.indexes_offset +
+                                             header.size * sizeof(std::uint64_t));
+    const auto keys_end = header.keys_offset + header.size * header.key_size;
+    if (bytes != end || (header.key_size > 0 && (header.keys_offset < nodes_end ||
+                                                 header.indexes_offset < keys_end))) {
+      throw std::runtime_error("corrupted disjoint set file");
+    }
+
+    if (verify) {
+      const auto words = std::span<const std::uint64_t>(
+          reinterpret_cast<const std::uint64_t*>(data + sizeof(header)),
+          (bytes - sizeof(header)) / sizeof(std::uint64_t));
+      if (fnv1a_words(words) != header.checksum) {
+        throw std::runtime_error("disjoint set file checksum mismatch");
+      }
+    }
+
+    return header;
+  }
+
+  // read a whole disjoint set file into memory, as 8-byte words
+  inline std::vector<std::uint64_t> read_disjoint_set_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+      throw std::runtime_error("cannot open " + path.string());
+    }
+
+    const auto bytes = static_cast<std::size_t>(in.tellg());
+    if (bytes % sizeof(std::uint64_t) != 0) {
+      throw std::runtime_error("corrupted disjoint set file");
+    }
+
+    std::vector<std::uint64_t> words(bytes / sizeof(std::uint64_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(words.data()), std::streamsize(bytes));
+    if (!in) {
+      throw std::runtime_error("cannot read " + path.string());
+    }
+
+    return words;
+  }
+}  // namespace jkds::container::detail
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace jkds::container::detail {
+
+  /***
+   * KeyedIndex
+   *
+   * The bijection between the elements of type T of a keyed disjoint set and the indexes
+   * [0, size()) of the nodes of its DenseDisjointSet, which are assigned in insertion order.
+   * Every element is stored once, as a key of the std::unordered_map<T, std::size_t> that maps
+   * it to its index, and the reverse mapping is a std::vector of pointers to those keys, which
+   * stay put when the map rehashes. Hence, an implementation of std::hash<T> is required.
+   * DisjointSet<T>, WeightedDisjointSet<T, W>, AggregateDisjointSet<T, A> and the shards of
+   * ShardedDisjointSet<T> are built on top of KeyedIndex.
+   */
+  template <typename T>
+  class KeyedIndex {
+  private:
+    std::unordered_map<T, std::size_t> index_map_;
+
+    // keys_[i] points to the element whose index is i, i.e. to its key in index_map_
+    std::vector<const T*> keys_;
+
+    // point to the keys of the index map in the order of their indexes
+    [[nodiscard]] static std::vector<const T*> init_keys(
+        const std::unordered_map<T, std::size_t>& index_map) {
+      std::vector<const T*> keys(index_map.size());
+      for (auto&& [x, i] : index_map) {
+        keys[i] = &x;
+      }
+      return keys;
+    }
+
+    // append the key of a newly inserted element to the reverse mapping, removing it from the
+    // index map if that throws
+    template <typename It>
+    std::pair<std::size_t, bool> link(std::pair<It, bool> emplaced) {
+      const auto [it, inserted] = emplaced;
+      if (inserted) {
+        try {
+          keys_.push_back(&it->first);
+        } catch (...) {
+          index_map_.erase(it);
+          throw;
+        }
+      }
+      return {it->second, inserted};
+    }
+
+  public:
+    KeyedIndex() = default;
+
+    // add the distinct elements of [first, last) in sequential order, starting from 0. A
+    // repeated element is added only once, at the position of its first occurrence
+    template <typename It>
+    KeyedIndex(It first, It last) {
+      const auto size = static_cast<std::size_t>(std::distance(first, last));
+      index_map_.reserve(size);
+      keys_.reserve(size);
+
+      for (; first != last; ++first) {
+        try_add(*first);
+      }
+    }
+
+    // the index map must be a bijection onto [0, index_map.size())
+    explicit KeyedIndex(std::unordered_map<T, std::size_t>&& index_map) :
+        index_map_(std::move(index_map)), keys_(init_keys(index_map_)) {
+    }
+
+    // the copy points to its own keys
+    KeyedIndex(const KeyedIndex& other) :
+        index_map_(other.index_map_), keys_(init_keys(index_map_)) {
+    }
+
+    // moving the index map moves its nodes too, so the pointers to the keys stay valid
+    KeyedIndex(KeyedIndex&&) = default;
+
+    KeyedIndex& operator=(const KeyedIndex& other) {
+      if (this != &other) {
+        *this = KeyedIndex(other);
+      }
+      return *this;
+    }
+
+    KeyedIndex& operator=(KeyedIndex&&) = default;
+
+    // return the number of elements
+    [[nodiscard]] std::size_t size() const noexcept {
+      return keys_.size();
+    }
+
+    // return true iff x is an element
+    [[nodiscard]] bool contains(const T& x) const {
+      return index_map_.contains(x);
+    }
+
+    // return the index of x, throwing std::out_of_range if x isn't an element
+    [[nodiscard]] std::size_t at(const T& x) const {
+      return index_map_.at(x);
+    }
+
+    // return the element whose index is i
+    [[nodiscard]] const T& key(std::size_t i) const noexcept {
+      assert(i < keys_.size());
+      return *keys_[i];
+    }
+
+    // iterate over the pairs of (element, index), in no particular order
+    [[nodiscard]] auto begin() const noexcept {
+      return index_map_.begin();
+    }
+
+    [[nodiscard]] auto end() const noexcept {
+      return index_map_.end();
+    }
+
+    // reserve the memory for a total of capacity elements, so that adding up to
+    // capacity - size() elements neither reallocates nor rehashes
+    void reserve(std::size_t capacity) {
+      keys_.reserve(capacity);
+
+      // unordered_map::reserve may also shrink the buckets to the current size, so it's only
+      // called to grow them
+      if (capacity > index_map_.bucket_count() * index_map_.max_load_factor()) {
+        index_map_.reserve(capacity);
+      }
+    }
+
+    // return the capacity of the reverse mapping
+    [[nodiscard]] std::size_t capacity() const noexcept {
+      return keys_.capacity();
+    }
+
+    // return the index of x, adding it with the next index if it's missing, and whether it
+    // was added. If it throws, nothing is added
+    std::pair<std::size_t, bool> try_add(const T& x) {
+      return link(index_map_.try_emplace(x, keys_.size()));
+    }
+
+    std::pair<std::size_t, bool> try_add(T&& x) {
+      return link(index_map_.try_emplace(std::move(x), keys_.size()));
+    }
+
+    // add x with the next index, and return it. Throw std::invalid_argument if x is already
+    // an element, in which case nothing is added
+    std::size_t add(const T& x) {
+      const auto [i, inserted] = try_add(x);
+      if (!inserted) {
+        throw std::invalid_argument("repeated element");
+      }
+      return i;
+    }
+
+    // remove the element with the largest index, i.e. the last one added
+    void pop_back() {
+      assert(!keys_.empty());
+      index_map_.erase(index_map_.find(*keys_.back()));
+      keys_.pop_back();
+    }
+
+    // remove the elements added after the first size ones
+    void truncate(std::size_t size) {
+      while (keys_.size() > size) {
+        pop_back();
+      }
+    }
+
+    // allocate the storage of the next permute, so that permute itself can't throw
+    [[nodiscard]] std::vector<const T*> prepare_permute() const {
+      return std::vector<const T*>(keys_.size());
+    }
+
+    // renumber the elements, so that the element whose index was i now has index
+    // permutation[i], using the storage returned by prepare_permute
+    void permute(const std::vector<std::size_t>& permutation,
+                 std::vector<const T*>&& keys) noexcept {
+      assert(permutation.size() == keys_.size() && keys.size() == keys_.size());
+      for (std::size_t i = 0; i < permutation.size(); ++i) {
+        keys[permutation[i]] = keys_[i];
+      }
+      keys_ = std::move(keys);
+
+      for (auto&& [_, index] : index_map_) {
+        index = permutation[index];
+      }
+    }
+  };
+}  // namespace jkds::container::detail
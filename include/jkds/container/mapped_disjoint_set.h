@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../util/mapped_file.h"
+#include "disjoint_set_file.h"
+
+#if JKDS_HAS_MMAP
+
+namespace jkds::container {
+
+  template <typename T>
+  requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+  class MappedDisjointSet;
+
+  /***
+   * MappedDenseDisjointSet
+   *
+   * A read-only view of a disjoint set file written by DenseDisjointSet::save (or by
+   * DisjointSet<T>::save, whose keys are ignored), which is memory mapped instead of being
+   * parsed. Opening the file only validates its header, and optionally its checksum, so that
+   * a disjoint set of any size can be queried right away; the pages are loaded lazily by the
+   * operating system, and shared by every process that maps the same file.
+   * Since every path was compressed by save, find visits a single node. Every method is const,
+   * hence it can be called concurrently by any number of threads.
+   * The nodes aren't validated upfront, so every query bounds-checks the parent it reads, and
+   * throws std::runtime_error if it's out of range, even if the checksum wasn't verified.
+   * Only available on POSIX systems, where JKDS_HAS_MMAP is defined as 1.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - find(std::size_t)
+   * - are_connected(std::size_t, std::size_t)
+   * - set_size(std::size_t)
+   */
+  class MappedDenseDisjointSet {
+  private:
+    template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+    friend class MappedDisjointSet;
+
+    jkds::util::MappedFile file_;
+    detail::DisjointSetFileHeader header_;
+    const detail::DisjointSetFileNode* nodes_;
+
+  public:
+    MappedDenseDisjointSet() = delete;
+
+    /***
+     * Map the disjoint set file at the given path. If verify is true, the checksum is verified
+     * too, which reads the whole file once.
+     * Throw std::system_error if the file can't be mapped, and std::runtime_error if it's
+     * corrupted.
+     */
+    explicit MappedDenseDisjointSet(const std::filesystem::path& path, bool verify = true) :
+        file_(path), header_(detail::check_disjoint_set_file(file_.data(), file_.size(), verify)),
+        nodes_(reinterpret_cast<const detail::DisjointSetFileNode*>(
+            file_.data() + sizeof(detail::DisjointSetFileHeader))) {
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return header_.size;
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return header_.num_sets;
+    }
+
+    /***
+     * find
+     *
+     * Return the representative of the set containing the element i.
+     * Throw std::out_of_range if i isn't an element.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] std::size_t find(std::size_t i) const {
+      if (i >= header_.size) {
+        throw std::out_of_range("MappedDenseDisjointSet: missing element");
+      }
+
+      const auto parent = nodes_[i].parent;
+      if (parent >= header_.size) {
+        throw std::runtime_error("corrupted disjoint set file");
+      }
+      return parent;
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * Throw std::out_of_range if either of them isn't an element.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(std::size_t i, std::size_t j) const {
+      return find(i) == find(j);
+    }
+
+    /***
+     * set_size
+     *
+     * Return the number of elements in the set containing the element i.
+     * Throw std::out_of_range if i isn't an element.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] std::size_t set_size(std::size_t i) const {
+      return nodes_[find(i)].size;
+    }
+  };
+
+  /***
+   * MappedDisjointSet
+   *
+   * A read-only view of a disjoint set file written by DisjointSet<T>::save, which is memory
+   * mapped instead of being parsed, as in MappedDenseDisjointSet.
+   * The elements are looked up by binary search over the sorted keys stored in the file, so
+   * no hash table has to be rebuilt.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - contains(const T&)
+   * - are_connected(const T&, const T&)
+   * - set_size(const T&)
+   */
+  template <typename T>
+  requires std::is_trivially_copyable_v<T> && std::totally_ordered<T>
+  class MappedDisjointSet {
+  private:
+    MappedDenseDisjointSet sets_;
+    std::span<const T> keys_;
+    std::span<const std::uint64_t> indexes_;
+
+    // return the index of x, or size() if x isn't an element. The index is read from the file,
+    // hence it's bounds-checked
+    [[nodiscard]] std::size_t index_of(const T& x) const {
+      const auto it = std::lower_bound(keys_.begin(), keys_.end(), x);
+      if (it == keys_.end() || x < *it) {
+        return keys_.size();
+      }
+
+      const auto index = indexes_[it - keys_.begin()];
+      if (index >= keys_.size()) {
+        throw std::runtime_error("corrupted disjoint set file");
+      }
+      return index;
+    }
+
+    // return the index of x, throwing std::out_of_range if x isn't an element
+    [[nodiscard]] std::size_t at(const T& x) const {
+      const auto i = index_of(x);
+      if (i == keys_.size()) {
+        throw std::out_of_range("MappedDisjointSet: missing element");
+      }
+      return i;
+    }
+
+  public:
+    MappedDisjointSet() = delete;
+
+    /***
+     * Map the disjoint set file at the given path. If verify is true, the checksum is verified
+     * too, which reads the whole file once.
+     * Throw std::system_error if the file can't be mapped, and std::runtime_error if it's
+     * corrupted, or its keys have a different size than T.
+     */
+    explicit MappedDisjointSet(const std::filesystem::path& path, bool verify = true) :
+        sets_(path, verify) {
+      const auto& header = sets_.header_;
+      if (header.key_size != sizeof(T)) {
+        throw std::runtime_error("disjoint set file with keys of a different type");
+      }
+
+      const auto data = sets_.file_.data();
+      keys_ = std::span<const T>(reinterpret_cast<const T*>(data + header.keys_offset),
+                                 header.size);
+      indexes_ = std::span<const std::uint64_t>(
+          reinterpret_cast<const std::uint64_t*>(data + header.indexes_offset), header.size);
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return sets_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return sets_.num_sets();
+    }
+
+    /***
+     * contains
+     *
+     * Return true iff x is an element of the disjoint set.
+     * Time: O(lg n), Space: O(1)
+     */
+    [[nodiscard]] bool contains(const T& x) const {
+      return index_of(x) != keys_.size();
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * Throw std::out_of_range if either of them isn't an element.
+     * Time: O(lg n), Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(const T& x, const T& y) const {
+      return sets_.are_connected(at(x), at(y));
+    }
+
+    /***
+     * set_size
+     *
+     * Return the number of elements in the set containing x.
+     * Throw std::out_of_range if x isn't an element.
+     * Time: O(lg n), Space: O(1)
+     */
+    [[nodiscard]] std::size_t set_size(const T& x) const {
+      return sets_.set_size(at(x));
+    }
+  };
+}  // namespace jkds::container
+
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace jkds::container {
+
+  /***
+   * Partition
+   *
+   * An immutable snapshot of a collection of disjoint groups of elements of type T, stored in
+   * the compressed sparse row (CSR) format: the members of every group are contiguous in a
+   * single std::vector<T>, and the group g spans the members in [offsets[g], offsets[g + 1]).
+   * Hence, a Partition requires exactly two allocations, regardless of the number of groups.
+   *
+   * Iterating a Partition yields one std::span<const T> per group.
+   *
+   * Public methods:
+   * - size()
+   * - empty()
+   * - group_size(std::size_t)
+   * - operator[](std::size_t)
+   * - begin()
+   * - end()
+   * - offsets()
+   * - members()
+   */
+  template <typename T>
+  class Partition {
+  private:
+    std::vector<std::size_t> offsets_;
+    std::vector<T> members_;
+
+  public:
+    class iterator {
+    private:
+      const Partition* partition_;
+      std::size_t group_;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = std::span<const T>;
+      using pointer = void;
+      using reference = value_type;
+
+      iterator() = default;
+
+      iterator(const Partition* partition, std::size_t group) :
+          partition_(partition), group_(group) {
+      }
+
+      value_type operator*() const {
+        return (*partition_)[group_];
+      }
+
+      iterator& operator++() {
+        ++group_;
+        return *this;
+      }
+
+      iterator operator++(int) {
+        auto tmp = *this;
+        ++(*this);
+        return tmp;
+      }
+
+      bool operator==(const iterator& other) const {
+        return group_ == other.group_;
+      }
+
+      bool operator!=(const iterator& other) const {
+        return !(*this == other);
+      }
+    };
+
+    Partition() : offsets_(1, 0) {
+    }
+
+    /***
+     * Build a partition from its CSR representation: offsets must start with 0, be sorted,
+     * and end with members.size().
+     */
+    Partition(std::vector<std::size_t>&& offsets, std::vector<T>&& members) noexcept :
+        offsets_(std::move(offsets)), members_(std::move(members)) {
+      assert(!offsets_.empty() && offsets_.front() == 0 && offsets_.back() == members_.size());
+    }
+
+    // return the number of groups
+    [[nodiscard]] std::size_t size() const noexcept {
+      return offsets_.size() - 1;
+    }
+
+    // return true iff there are no groups
+    [[nodiscard]] bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    // return the number of members of the g-th group
+    [[nodiscard]] std::size_t group_size(std::size_t g) const noexcept {
+      return offsets_[g + 1] - offsets_[g];
+    }
+
+    // return the members of the g-th group
+    [[nodiscard]] std::span<const T> operator[](std::size_t g) const noexcept {
+      assert(g < size());
+      return std::span<const T>(members_.data() + offsets_[g], group_size(g));
+    }
+
+    [[nodiscard]] iterator begin() const noexcept {
+      return iterator(this, 0);
+    }
+
+    [[nodiscard]] iterator end() const noexcept {
+      return iterator(this, size());
+    }
+
+    // return the size() + 1 offsets delimiting the groups in members()
+    [[nodiscard]] std::span<const std::size_t> offsets() const noexcept {
+      return offsets_;
+    }
+
+    // return the members of every group, stored contiguously group after group
+    [[nodiscard]] std::span<const T> members() const noexcept {
+      return members_;
+    }
+  };
+}  // namespace jkds::container
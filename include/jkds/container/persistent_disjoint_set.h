@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace jkds::container {
+
+  /***
+   * PersistentDisjointSet
+   *
+   * A persistent (i.e., versioned) Disjoint Set data structure (also known as Union-Find) whose
+   * elements are the dense integer ids [0, size()).
+   * Every unite produces a new version and leaves the previous ones untouched, so that
+   * connectivity can be queried "as of" any version. The initial version, where every element
+   * is a singleton, is 0.
+   *
+   * The parents and ranks of the elements are stored in a persistent array, implemented as a
+   * path-copying balanced binary tree: setting an entry copies the O(lg n) nodes on the path
+   * from the root to its leaf, and shares every other node with the previous version.
+   * Path compression would copy a path for every find, so PersistentDisjointSet only implements
+   * the union-by-rank policy: find visits O(lg n) elements, each read in O(lg n) time, and every
+   * unite allocates at most 2 (lg n + 1) nodes of two words each.
+   *
+   * Public methods:
+   * - size()
+   * - num_versions()
+   * - num_nodes()
+   * - find(std::size_t, std::size_t)
+   * - unite(std::size_t, std::size_t, std::size_t)
+   * - are_connected(std::size_t, std::size_t, std::size_t)
+   */
+  class PersistentDisjointSet {
+  private:
+    // An internal node of the persistent array stores the indexes of its children in nodes_,
+    // whereas a leaf stores the parent and the rank of an element.
+    struct Node {
+      std::size_t first;
+      std::size_t second;
+    };
+
+    std::size_t size_;
+    std::vector<Node> nodes_;
+
+    // versions_[v] is the index of the root of the persistent array in the v-th version
+    std::vector<std::size_t> versions_;
+
+    // build the subtree covering the elements in [lo, hi), returning the index of its root
+    std::size_t build(std::size_t lo, std::size_t hi) {
+      if (hi - lo == 1) {
+        nodes_.push_back({lo, 0});
+      } else {
+        const auto mid = lo + (hi - lo) / 2;
+        const auto left = build(lo, mid);
+        const auto right = build(mid, hi);
+        nodes_.push_back({left, right});
+      }
+
+      return nodes_.size() - 1;
+    }
+
+    // return the leaf of the element i in the persistent array rooted at root
+    [[nodiscard]] const Node& leaf(std::size_t root, std::size_t i) const noexcept {
+      std::size_t lo = 0;
+      std::size_t hi = size_;
+
+      while (hi - lo > 1) {
+        const auto mid = lo + (hi - lo) / 2;
+        if (i < mid) {
+          root = nodes_[root].first;
+          hi = mid;
+        } else {
+          root = nodes_[root].second;
+          lo = mid;
+        }
+      }
+
+      return nodes_[root];
+    }
+
+    // copy the path from root to the leaf of the element i, replacing that leaf with the given
+    // one, and return the index of the new root
+    std::size_t set_leaf(std::size_t root, std::size_t i, Node value) {
+      // the tree is balanced, so its height never exceeds the number of bits of std::size_t
+      std::array<std::size_t, 8 * sizeof(std::size_t)> path;
+      std::array<bool, 8 * sizeof(std::size_t)> went_right;
+      std::size_t depth = 0;
+      std::size_t lo = 0;
+      std::size_t hi = size_;
+
+      while (hi - lo > 1) {
+        const auto mid = lo + (hi - lo) / 2;
+        path[depth] = root;
+        went_right[depth] = i >= mid;
+
+        if (went_right[depth]) {
+          root = nodes_[root].second;
+          lo = mid;
+        } else {
+          root = nodes_[root].first;
+          hi = mid;
+        }
+        ++depth;
+      }
+
+      nodes_.push_back(value);
+      auto child = nodes_.size() - 1;
+
+      while (depth > 0) {
+        --depth;
+        auto copy = nodes_[path[depth]];
+        (went_right[depth] ? copy.second : copy.first) = child;
+        nodes_.push_back(copy);
+        child = nodes_.size() - 1;
+      }
+
+      return child;
+    }
+
+  public:
+    PersistentDisjointSet() = delete;
+
+    explicit PersistentDisjointSet(std::size_t size) : size_(size) {
+      // initialize every item as the parent of itself with rank 0
+      if (size_ > 0) {
+        nodes_.reserve(2 * size_ - 1);
+        versions_.push_back(build(0, size_));
+      } else {
+        versions_.push_back(0);
+      }
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    // return the number of versions, i.e. the number of unite calls plus one
+    [[nodiscard]] std::size_t num_versions() const noexcept {
+      return versions_.size();
+    }
+
+    // return the number of two-word nodes allocated by every version together
+    [[nodiscard]] std::size_t num_nodes() const noexcept {
+      return nodes_.size();
+    }
+
+    /***
+     * find
+     *
+     * Return the representative of the set containing the element i in the given version.
+     * Time: O(lg^2 n), Space: O(1)
+     */
+    [[nodiscard]] std::size_t find(std::size_t version, std::size_t i) const noexcept {
+      assert(version < versions_.size() && i < size_);
+      const auto root = versions_[version];
+
+      for (auto parent = leaf(root, i).first; parent != i; parent = leaf(root, i).first) {
+        i = parent;
+      }
+
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Create a new version of the disjoint set, where the two sets which contain the i and j
+     * elements in the given version are merged. Return the number of the new version.
+     * Time: O(lg^2 n), Space: O(lg n)
+     */
+    std::size_t unite(std::size_t version, std::size_t i, std::size_t j) {
+      i = find(version, i);
+      j = find(version, j);
+      auto root = versions_[version];
+
+      if (i != j) {
+        auto rank_i = leaf(root, i).second;
+        auto rank_j = leaf(root, j).second;
+
+        // if two sets are united and have different ranks,
+        // the resulting set's rank is the larger of the two
+        if (rank_i < rank_j) {
+          std::swap(i, j);
+          std::swap(rank_i, rank_j);
+        }
+
+        root = set_leaf(root, j, {i, rank_j});
+
+        // if two sets are united and have the same rank,
+        // the resulting representative set's rank is one unit larger
+        if (rank_i == rank_j) {
+          root = set_leaf(root, i, {i, rank_i + 1});
+        }
+      }
+
+      versions_.push_back(root);
+      return versions_.size() - 1;
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set
+     * in the given version.
+     * Time: O(lg^2 n), Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(std::size_t version, std::size_t i,
+                                     std::size_t j) const noexcept {
+      return find(version, i) == find(version, j);
+    }
+  };
+}  // namespace jkds::container
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include "../functional/fmap.h"
+#include "../util/range.h"
+
+namespace jkds::container {
+
+  /***
+   * RollbackDisjointSet
+   *
+   * A Disjoint Set data structure (also known as Union-Find) whose elements are the dense
+   * integer ids [0, size()), and whose merges can be undone in reverse order.
+   *
+   * Path compression rewrites parents during find, so it can't be undone cheaply: instead,
+   * RollbackDisjointSet only implements the union-by-rank policy, which bounds the height of
+   * every tree, and hence the time complexity of find, to O(lg n).
+   * Every successful unite pushes the performed link on an undo stack: snapshot() returns the
+   * current height of that stack, and rollback(snapshot) pops and undoes every link pushed since.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - find(std::size_t)
+   * - unite(std::size_t, std::size_t)
+   * - are_connected(std::size_t, std::size_t)
+   * - snapshot()
+   * - rollback(std::size_t)
+   */
+  class RollbackDisjointSet {
+  private:
+    struct Node {
+      std::size_t parent;
+      std::size_t rank = 0;
+
+      Node(std::size_t parent) : parent(parent) {
+      }
+    };
+
+    // a link of the representative child below another representative
+    struct Link {
+      std::size_t child;
+      bool rank_increased;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<Link> history_;
+    std::size_t num_sets_;
+
+    // initialize every item as the parent of itself with rank 0
+    [[nodiscard]] static std::vector<Node> init_nodes(std::size_t size) noexcept {
+      auto parents(jkds::util::range<std::size_t>(size));
+      return jkds::functional::fmap(
+          [](std::size_t parent) {
+            return Node(parent);
+          },
+          parents);
+    }
+
+  public:
+    RollbackDisjointSet() = delete;
+
+    explicit RollbackDisjointSet(std::size_t size) noexcept :
+        nodes_(init_nodes(size)), num_sets_(size) {
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return nodes_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return num_sets_;
+    }
+
+    /***
+     * find
+     *
+     * Return the representative of the set containing the element i.
+     * Time: O(lg n), Space: O(1)
+     */
+    [[nodiscard]] std::size_t find(std::size_t i) const noexcept {
+      assert(i < nodes_.size());
+
+      while (i != nodes_[i].parent) {
+        i = nodes_[i].parent;
+      }
+
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Merge the two sets which contain the i and j elements, respectively, into a new set
+     * that is the union of the two sets, and record the merge on the undo stack.
+     * Return true iff i and j were in different sets before the call. If it throws, nothing
+     * is merged.
+     * Time: O(lg n), Space: O(1) amortized
+     */
+    bool unite(std::size_t i, std::size_t j) {
+      i = find(i);
+      j = find(j);
+
+      if (i == j) {
+        return false;
+      }
+
+      // if two sets are united and have different ranks,
+      // the resulting set's rank is the larger of the two
+      if (nodes_[i].rank < nodes_[j].rank) {
+        std::swap(i, j);
+      }
+
+      // if two sets are united and have the same rank,
+      // the resulting representative set's rank is one unit larger
+      const bool rank_increased = nodes_[i].rank == nodes_[j].rank;
+
+      // the link is recorded first, so that if that throws, the sets are left unchanged
+      history_.push_back({j, rank_increased});
+      nodes_[j].parent = i;
+      nodes_[i].rank += rank_increased;
+      --num_sets_;
+      return true;
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set.
+     * Time: O(lg n), Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(std::size_t i, std::size_t j) const noexcept {
+      return find(i) == find(j);
+    }
+
+    /***
+     * snapshot
+     *
+     * Return a handle to the current state of the disjoint set, to be passed to rollback.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] std::size_t snapshot() const noexcept {
+      return history_.size();
+    }
+
+    /***
+     * rollback
+     *
+     * Undo every merge performed since the given snapshot was taken, in reverse order.
+     * Time: O(k), where k is the number of undone merges, Space: O(1)
+     */
+    void rollback(std::size_t snapshot) noexcept {
+      assert(snapshot <= history_.size());
+
+      while (history_.size() > snapshot) {
+        const auto [child, rank_increased] = history_.back();
+        history_.pop_back();
+
+        auto& parent = nodes_[nodes_[child].parent];
+        parent.rank -= rank_increased;
+        nodes_[child].parent = child;
+        ++num_sets_;
+      }
+    }
+  };
+}  // namespace jkds::container
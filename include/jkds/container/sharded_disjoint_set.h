@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "../util/parallel.h"
+#include "concurrent_disjoint_set.h"
+#include "dense_disjoint_set.h"
+#include "keyed_index.h"
+
+namespace jkds::container {
+
+  /***
+   * ShardedDisjointSet
+   *
+   * A Disjoint Set data structure (also known as Union-Find) for many threads that unite
+   * disjoint streams of pairs of elements of type T, without any contention.
+   * Every thread unites the pairs it sees into its own Shard, which is a private union-find
+   * over the elements seen by that thread. Since the same element may appear in several
+   * shards, each shard implicitly buffers the equivalences between its elements and their
+   * copies in the other shards. merge() resolves them, and computes the global sets:
+   * 1. every shard finds the local representative of each of its elements, in parallel;
+   * 2. the elements are partitioned by hash, and every partition assigns global ids to its
+   *    distinct elements, in parallel;
+   * 3. every shard unites each of its elements with its local representative in a
+   *    ConcurrentDisjointSet over the global ids, in parallel.
+   * After merge(), the global sets can be queried concurrently by any number of threads, as
+   * long as no shard is modified. Uniting more pairs requires another merge(), which starts
+   * over from the shards.
+   * An implementation of std::hash<T> is required.
+   *
+   * Public methods:
+   * - num_shards()
+   * - shard(std::size_t)
+   * - merge(std::size_t)
+   * - size()
+   * - num_sets()
+   * - contains(const T&)
+   * - component_of(const T&)
+   * - are_connected(const T&, const T&)
+   */
+  template <typename T>
+  class ShardedDisjointSet {
+  public:
+    /***
+     * Shard
+     *
+     * The private union-find of a single thread, whose elements are added on first use, and
+     * mapped to the indexes of a DenseDisjointSet by a detail::KeyedIndex.
+     * A shard must be used by one thread at a time. Shards are aligned to a cache line, so
+     * that threads working on different shards never share one.
+     */
+    class alignas(64) Shard {
+    private:
+      friend class ShardedDisjointSet;
+
+      detail::KeyedIndex<T> index_;
+      DenseDisjointSet sets_{0};
+
+      // return the local index of x, adding it as a singleton if it's missing
+      std::size_t index_of(const T& x) {
+        const auto [i, inserted] = index_.try_add(x);
+        if (inserted) {
+          try {
+            sets_.add();
+          } catch (...) {
+            index_.pop_back();
+            throw;
+          }
+        }
+        return i;
+      }
+
+    public:
+      // return the number of distinct elements seen by this shard
+      [[nodiscard]] std::size_t size() const noexcept {
+        return index_.size();
+      }
+
+      // add x to the shard as a singleton, if it's missing
+      void add(const T& x) {
+        index_of(x);
+      }
+
+      /***
+       * unite
+       *
+       * Merge the sets of this shard which contain x and y, adding them if they're missing.
+       * Return true iff x and y were in different sets of this shard before the call.
+       * Time: O(lg^* n) amortized, Space: O(1) amortized
+       */
+      bool unite(const T& x, const T& y) {
+        const auto i = index_of(x);
+        return sets_.unite(i, index_of(y));
+      }
+    };
+
+  private:
+    std::vector<Shard> shards_;
+
+    // buckets_[b] maps the elements whose hash is b modulo the number of buckets to their
+    // global id, minus offsets_[b]
+    std::vector<std::unordered_map<T, std::size_t>> buckets_;
+    std::vector<std::size_t> offsets_{0};
+
+    // labels_[g] is the dense component label of the element with global id g
+    std::vector<std::size_t> labels_;
+    std::size_t num_sets_ = 0;
+
+    [[nodiscard]] static std::size_t bucket_of(const T& x, std::size_t num_buckets) noexcept {
+      return std::hash<T>{}(x) % num_buckets;
+    }
+
+    // return the global id of x, which must have been merged
+    [[nodiscard]] std::size_t global_id(const T& x) const {
+      const auto b = bucket_of(x, buckets_.size());
+      return offsets_[b] + buckets_[b].at(x);
+    }
+
+  public:
+    ShardedDisjointSet() = delete;
+
+    explicit ShardedDisjointSet(std::size_t num_shards) : shards_(num_shards) {
+    }
+
+    // return the number of shards
+    [[nodiscard]] std::size_t num_shards() const noexcept {
+      return shards_.size();
+    }
+
+    // return the t-th shard, which is meant to be used by a single thread
+    [[nodiscard]] Shard& shard(std::size_t t) noexcept {
+      assert(t < shards_.size());
+      return shards_[t];
+    }
+
+    /***
+     * merge
+     *
+     * Compute the global sets, i.e. the connected components of the union of the sets of
+     * every shard, splitting the work among num_threads threads.
+     * The results are built aside, and replace the ones of the previous merge only once the
+     * whole merge succeeded: if it throws, e.g. std::bad_alloc from any thread, the global sets
+     * of the previous merge are left unchanged.
+     * Time: O(n lg^* n / num_threads + n), Space: O(n), where n is the total size of the shards
+     */
+    void merge(std::size_t num_threads = jkds::util::default_num_threads()) {
+      const auto num_shards = shards_.size();
+      const auto num_buckets = std::max<std::size_t>(1, num_threads);
+
+      // the buffers indexed by shard are sized upfront, on the calling thread.
+      // roots[s][i] is the local representative of the i-th element of the shard s, and
+      // global[s][i] is initially the id of that element within its bucket
+      std::vector<std::vector<std::size_t>> roots(num_shards);
+      std::vector<std::vector<std::size_t>> global(num_shards);
+      for (std::size_t s = 0; s < num_shards; ++s) {
+        roots[s].resize(shards_[s].size());
+        global[s].resize(shards_[s].size());
+      }
+      std::vector<std::vector<std::vector<std::size_t>>> groups(
+          num_shards, std::vector<std::vector<std::size_t>>(num_buckets));
+      std::vector<std::unordered_map<T, std::size_t>> buckets(num_buckets);
+
+      // 1. local representatives, and local indexes grouped by bucket
+      jkds::util::parallel_for(0, num_shards, [&](std::size_t first, std::size_t last) {
+        for (auto s = first; s < last; ++s) {
+          auto& shard = shards_[s];
+          for (std::size_t i = 0; i < shard.size(); ++i) {
+            roots[s][i] = shard.sets_.find(i);
+            groups[s][bucket_of(shard.index_.key(i), num_buckets)].push_back(i);
+          }
+        }
+      }, num_threads);
+
+      // 2. ids of the distinct elements within every bucket
+      jkds::util::parallel_for(0, num_buckets, [&](std::size_t first, std::size_t last) {
+        for (auto b = first; b < last; ++b) {
+          auto& bucket = buckets[b];
+          for (std::size_t s = 0; s < num_shards; ++s) {
+            for (auto i : groups[s][b]) {
+              const auto [it, _] = bucket.try_emplace(shards_[s].index_.key(i), bucket.size());
+              global[s][i] = it->second;
+            }
+          }
+        }
+      }, num_threads);
+
+      // buckets[b] maps its elements to their global id, minus offsets[b]
+      std::vector<std::size_t> offsets(num_buckets + 1, 0);
+      for (std::size_t b = 0; b < num_buckets; ++b) {
+        offsets[b + 1] = offsets[b] + buckets[b].size();
+      }
+
+      // 3. global ids, and the union of every element with its local representative
+      ConcurrentDisjointSet sets{offsets.back()};
+
+      jkds::util::parallel_for(0, num_shards, [&](std::size_t first, std::size_t last) {
+        for (auto s = first; s < last; ++s) {
+          for (std::size_t b = 0; b < num_buckets; ++b) {
+            for (auto i : groups[s][b]) {
+              global[s][i] += offsets[b];
+            }
+          }
+          for (std::size_t i = 0; i < roots[s].size(); ++i) {
+            if (roots[s][i] != i) {
+              sets.unite(global[s][i], global[s][roots[s][i]]);
+            }
+          }
+        }
+      }, num_threads);
+
+      sets.compress(num_threads);
+
+      // dense labels, numbered in increasing order of the smallest global id of every set
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+      const auto n = sets.size();
+      std::vector<std::size_t> root_labels(n, unlabeled);
+      std::vector<std::size_t> labels(n);
+      std::size_t num_sets = 0;
+
+      for (std::size_t g = 0; g < n; ++g) {
+        auto& label = root_labels[sets.find(g)];
+        if (label == unlabeled) {
+          label = num_sets++;
+        }
+        labels[g] = label;
+      }
+
+      buckets_ = std::move(buckets);
+      offsets_ = std::move(offsets);
+      labels_ = std::move(labels);
+      num_sets_ = num_sets;
+    }
+
+    // return the number of distinct elements, as of the last merge
+    [[nodiscard]] std::size_t size() const noexcept {
+      return labels_.size();
+    }
+
+    // return the number of global sets, as of the last merge
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return num_sets_;
+    }
+
+    /***
+     * contains
+     *
+     * Return true iff x was seen by any shard, as of the last merge.
+     * Time: O(1) on average, Space: O(1)
+     */
+    [[nodiscard]] bool contains(const T& x) const {
+      return !buckets_.empty() && buckets_[bucket_of(x, buckets_.size())].contains(x);
+    }
+
+    /***
+     * component_of
+     *
+     * Return the dense label in [0, num_sets()) of the global set containing x, as of the
+     * last merge. Throw std::out_of_range if x wasn't seen by any shard.
+     * Time: O(1) on average, Space: O(1)
+     */
+    [[nodiscard]] std::size_t component_of(const T& x) const {
+      if (buckets_.empty()) {
+        throw std::out_of_range("ShardedDisjointSet::component_of before merge");
+      }
+      return labels_[global_id(x)];
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if x and y are in the same global set, as of the last merge.
+     * Throw std::out_of_range if either of them wasn't seen by any shard.
+     * Time: O(1) on average, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(const T& x, const T& y) const {
+      return component_of(x) == component_of(y);
+    }
+  };
+}  // namespace jkds::container
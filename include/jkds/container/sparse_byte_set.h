@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string.h>
+#include <cstddef>
 #include <cstdint>
 
 namespace jkds::container {
@@ -15,27 +15,32 @@ namespace jkds::container {
    * - add(uint8_t)
    * - contains(uint8_t)
    * - reset()
+   * - size()
+   * - begin()
+   * - end()
    *
    * Performance concerns:
    * - This set never allocates.
    * - Every method runs in constant time (with a small constant factor)
+   * - Every method is constexpr, so that a set can be built at compile time.
    *
    * This data structure is inspired by "An Efficient Representation for Sparse Sets",
-   * by Preston Briggs and Linda Torczon.
+   * by Preston Briggs and Linda Torczon. See SparseSet for arbitrary universes, with erase
+   * and iteration.
    */
   class SparseByteSet {
   public:
     // 256 is 2^8
     static constexpr uint16_t capacity = 256;
 
-    SparseByteSet() : size_(0) {
+    constexpr SparseByteSet() : size_(0), sparse_{}, dense_{} {
     }
 
     /***
      * Add a new byte to the set.
      * Time: O(1), Space: O(1)
      */
-    inline bool add(uint8_t byte) {
+    constexpr bool add(uint8_t byte) {
       bool result = !contains(byte);
 
       if (result) {
@@ -52,18 +57,31 @@ namespace jkds::container {
      * Check whether a given byte is in the set.
      * Time: O(1), Space: O(1)
      */
-    inline bool contains(uint8_t byte) const {
+    constexpr bool contains(uint8_t byte) const {
       return sparse_[byte] < size_ && dense_[sparse_[byte]] == byte;
     }
 
     /***
-     * Reset the byte set.
-     * Time: O(256), Space: O(1)
+     * Reset the byte set. The arrays are left as they are, since contains only trusts the
+     * entries below size_.
+     * Time: O(1), Space: O(1)
      */
-    void reset() {
+    constexpr void reset() {
       size_ = 0;
-      memset(sparse_, 0, sizeof(sparse_));
-      memset(dense_, 0, sizeof(dense_));
+    }
+
+    // return the number of bytes in the set
+    [[nodiscard]] constexpr std::size_t size() const {
+      return size_;
+    }
+
+    // iterate over the bytes in the set, in the order they were added
+    [[nodiscard]] constexpr const uint8_t* begin() const {
+      return dense_;
+    }
+
+    [[nodiscard]] constexpr const uint8_t* end() const {
+      return dense_ + size_;
     }
 
   private:
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jkds::container {
+
+  /***
+   * SparseMap
+   *
+   * A map from the integers in the universe [0, universe()) to values, with the layout of
+   * SparseSet: the keys and the values are stored densely, in two parallel arrays, and the
+   * sparse array maps every key to its position in the dense arrays. Hence insert, find and
+   * erase run in O(1), erase moves the last entry into the hole, and values() is a contiguous
+   * span that a loop can traverse (and vectorize) without any hashing or pointer chasing,
+   * which makes SparseMap a good fit for entity-to-component storage.
+   *
+   * The sparse array is split into pages of PageSize keys, which are allocated (and filled)
+   * the first time one of their keys is inserted, so that a large universe with few keys, or
+   * with clustered keys, doesn't pay for a full sparse array. The pages are kept until the
+   * map is destroyed.
+   * Key is also the type of the positions in the dense arrays, so the universe can't exceed
+   * the largest value of Key.
+   *
+   * Public methods:
+   * - universe()
+   * - size()
+   * - empty()
+   * - allocated_pages()
+   * - reserve(std::size_t)
+   * - contains(Key)
+   * - find(Key)
+   * - at(Key)
+   * - insert(Key, Value)
+   * - operator[](Key)
+   * - erase(Key)
+   * - clear()
+   * - keys()
+   * - values()
+   */
+  template <std::unsigned_integral Key, typename Value, std::size_t PageSize = 4096>
+  class SparseMap {
+  private:
+    static_assert(PageSize > 0 && (PageSize & (PageSize - 1)) == 0,
+                  "PageSize must be a power of 2");
+    static_assert(!std::is_same_v<Value, bool>,
+                  "std::vector<bool> isn't contiguous, use a byte-sized value instead");
+
+    // the sparse entry of the keys which aren't in the map
+    static constexpr Key absent = std::numeric_limits<Key>::max();
+
+    std::size_t universe_;
+    std::vector<std::unique_ptr<Key[]>> pages_;
+    std::size_t allocated_pages_ = 0;
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+
+    // return the position of key in the dense arrays, or absent
+    [[nodiscard]] Key position(Key key) const noexcept {
+      if (key >= universe_) {
+        return absent;
+      }
+      const auto& page = pages_[key / PageSize];
+      return page ? page[key % PageSize] : absent;
+    }
+
+    // return the sparse entry of key, allocating its page if needed
+    Key& entry(Key key) {
+      auto& page = pages_[key / PageSize];
+      if (!page) {
+        page = std::make_unique_for_overwrite<Key[]>(PageSize);
+        std::fill_n(page.get(), PageSize, absent);
+        ++allocated_pages_;
+      }
+      return page[key % PageSize];
+    }
+
+    // append key to the dense keys, right after its value has been appended, dropping the value
+    // again if the keys can't grow, so that the dense arrays always have the same size
+    void push_key(Key key) {
+      try {
+        keys_.push_back(key);
+      } catch (...) {
+        values_.pop_back();
+        throw;
+      }
+    }
+
+    [[nodiscard]] Key checked(Key key) const {
+      if (key >= universe_) {
+        throw std::out_of_range("SparseMap: key out of the universe");
+      }
+      return key;
+    }
+
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+
+    SparseMap() = delete;
+
+    /***
+     * Create an empty map over the keys in [0, universe). No page is allocated yet.
+     * Throw std::invalid_argument if the universe doesn't fit in Key.
+     * Time: O(universe / PageSize), Space: O(universe / PageSize)
+     */
+    explicit SparseMap(std::size_t universe) : universe_(universe) {
+      if (universe > std::size_t(absent)) {
+        throw std::invalid_argument("SparseMap: universe too large for the key type");
+      }
+      pages_.resize((universe + PageSize - 1) / PageSize);
+    }
+
+    // return the size of the universe
+    [[nodiscard]] std::size_t universe() const noexcept {
+      return universe_;
+    }
+
+    // return the number of entries
+    [[nodiscard]] std::size_t size() const noexcept {
+      return keys_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return keys_.empty();
+    }
+
+    // return the number of pages of the sparse array which have been allocated
+    [[nodiscard]] std::size_t allocated_pages() const noexcept {
+      return allocated_pages_;
+    }
+
+    // reserve room for the given number of entries in the dense arrays
+    void reserve(std::size_t capacity) {
+      keys_.reserve(capacity);
+      values_.reserve(capacity);
+    }
+
+    /***
+     * contains
+     *
+     * Return true iff key is in the map. The keys out of the universe are never in the map.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] bool contains(Key key) const noexcept {
+      return position(key) != absent;
+    }
+
+    /***
+     * find
+     *
+     * Return a pointer to the value of key, or nullptr if key isn't in the map. The pointer is
+     * invalidated by any insertion or erasure.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] Value* find(Key key) noexcept {
+      const auto i = position(key);
+      return i == absent ? nullptr : &values_[i];
+    }
+
+    [[nodiscard]] const Value* find(Key key) const noexcept {
+      const auto i = position(key);
+      return i == absent ? nullptr : &values_[i];
+    }
+
+    /***
+     * at
+     *
+     * Return the value of key. Throw std::out_of_range if key isn't in the map.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] Value& at(Key key) {
+      if (auto value = find(key)) {
+        return *value;
+      }
+      throw std::out_of_range("SparseMap: missing key");
+    }
+
+    [[nodiscard]] const Value& at(Key key) const {
+      if (auto value = find(key)) {
+        return *value;
+      }
+      throw std::out_of_range("SparseMap: missing key");
+    }
+
+    /***
+     * insert
+     *
+     * Insert key with the given value at the end of the dense arrays, returning true, unless
+     * key is already in the map, in which case its value is left as it is and false is
+     * returned. Throw std::out_of_range if key is out of the universe. If the value can't be
+     * inserted, e.g. its move constructor throws, no entry is added.
+     * Time: O(1) amortized, Space: O(1) amortized
+     */
+    bool insert(Key key, Value value) {
+      auto& i = entry(checked(key));
+      if (i != absent) {
+        return false;
+      }
+
+      values_.push_back(std::move(value));
+      push_key(key);
+      i = static_cast<Key>(keys_.size() - 1);
+      return true;
+    }
+
+    /***
+     * operator[]
+     *
+     * Return the value of key, inserting a value-initialized one first if key isn't in the
+     * map. Throw std::out_of_range if key is out of the universe.
+     * Time: O(1) amortized, Space: O(1) amortized
+     */
+    Value& operator[](Key key) {
+      auto& i = entry(checked(key));
+      if (i == absent) {
+        values_.emplace_back();
+        push_key(key);
+        i = static_cast<Key>(keys_.size() - 1);
+      }
+      return values_[i];
+    }
+
+    /***
+     * erase
+     *
+     * Remove key from the map, returning true iff it was in the map. The last entry of the
+     * dense arrays takes the place of the erased one.
+     * Time: O(1), Space: O(1)
+     */
+    bool erase(Key key) {
+      // absent is never a valid position, so the bound check also tells the compiler that the
+      // dense arrays aren't empty below
+      const auto i = position(key);
+      if (i >= keys_.size()) {
+        return false;
+      }
+
+      // the last entry fills the hole, unless it's the erased one
+      const auto moved = keys_.back();
+      if (i != keys_.size() - 1) {
+        values_[i] = std::move(values_.back());
+        keys_[i] = moved;
+        entry(moved) = i;
+      }
+      entry(key) = absent;
+      keys_.pop_back();
+      values_.pop_back();
+      return true;
+    }
+
+    /***
+     * clear
+     *
+     * Remove every entry, resetting only the sparse entries of the keys in the map. The pages
+     * stay allocated.
+     * Time: O(size()), Space: O(1)
+     */
+    void clear() noexcept {
+      for (auto key : keys_) {
+        pages_[key / PageSize][key % PageSize] = absent;
+      }
+      keys_.clear();
+      values_.clear();
+    }
+
+    // return the keys in the dense order, where keys()[i] is the key of values()[i]
+    [[nodiscard]] std::span<const Key> keys() const noexcept {
+      return keys_;
+    }
+
+    // return the values in the dense order, i.e. in insertion order, up to erasures
+    [[nodiscard]] std::span<Value> values() noexcept {
+      return values_;
+    }
+
+    [[nodiscard]] std::span<const Value> values() const noexcept {
+      return values_;
+    }
+  };
+}  // namespace jkds::container
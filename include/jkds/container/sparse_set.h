@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace jkds::container {
+
+  // the universe size of a SparseSet whose universe is chosen at runtime
+  inline constexpr std::size_t dynamic_universe = 0;
+
+  namespace detail {
+
+    // the smallest unsigned integer type whose values span a universe of size N, or
+    // std::uint32_t if the universe is chosen at runtime
+    template <std::size_t N>
+    using sparse_index_t = std::conditional_t<
+        N == dynamic_universe, std::uint32_t,
+        std::conditional_t<
+            N <= (std::uint64_t(1) << 8), std::uint8_t,
+            std::conditional_t<
+                N <= (std::uint64_t(1) << 16), std::uint16_t,
+                std::conditional_t<N <= (std::uint64_t(1) << 32), std::uint32_t,
+                                   std::uint64_t>>>>;
+  }  // namespace detail
+
+  /***
+   * SparseSet
+   *
+   * A set of integers in the universe [0, universe()), following "An Efficient Representation
+   * for Sparse Sets", by Preston Briggs and Linda Torczon.
+   * The members are stored contiguously in the dense array, and sparse[x] is the position of
+   * x in the dense array: x is a member iff that position is within size() and points back to
+   * x. Hence clear only resets the size, erase moves the last member into the hole, and the
+   * members are iterated over in O(size()) rather than O(universe()), which makes SparseSet a
+   * good fit for visited sets that are cleared at every iteration.
+   *
+   * N is the universe size, if it's known at compile time, in which case the arrays are stored
+   * inline and never allocate, or dynamic_universe, in which case it's passed to the
+   * constructor. IndexT is the type of the members and of their positions, which by default is
+   * the smallest unsigned integer type spanning the universe (std::uint32_t for a runtime
+   * universe).
+   * The arrays are zeroed once by the constructor, which is the only O(universe()) operation.
+   *
+   * Public methods:
+   * - universe()
+   * - size()
+   * - empty()
+   * - add(IndexT)
+   * - contains(IndexT)
+   * - erase(IndexT)
+   * - clear()
+   * - begin()
+   * - end()
+   */
+  template <std::size_t N = dynamic_universe, std::unsigned_integral IndexT =
+                                                  detail::sparse_index_t<N>>
+  class SparseSet {
+  private:
+    static_assert(N == dynamic_universe || N - 1 <= std::size_t(IndexT(-1)),
+                  "IndexT can't represent every member of the universe");
+
+    using storage_t =
+        std::conditional_t<N == dynamic_universe, std::vector<IndexT>, std::array<IndexT, N>>;
+
+    std::size_t size_ = 0;
+    storage_t dense_{};
+    storage_t sparse_{};
+
+  public:
+    using value_type = IndexT;
+    using const_iterator = const IndexT*;
+
+    SparseSet() requires(N != dynamic_universe) = default;
+
+    explicit SparseSet(std::size_t universe) requires(N == dynamic_universe) :
+        dense_(universe), sparse_(universe) {
+      assert(universe == 0 || universe - 1 <= std::size_t(IndexT(-1)));
+    }
+
+    // return the size of the universe
+    [[nodiscard]] std::size_t universe() const noexcept {
+      return sparse_.size();
+    }
+
+    // return the number of members
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return size_ == 0;
+    }
+
+    /***
+     * contains
+     *
+     * Return true iff x is a member of the set.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] bool contains(IndexT x) const noexcept {
+      assert(x < universe());
+      const auto position = sparse_[x];
+      return position < size_ && dense_[position] == x;
+    }
+
+    /***
+     * add
+     *
+     * Add x to the set, returning true iff it wasn't a member.
+     * Time: O(1), Space: O(1)
+     */
+    bool add(IndexT x) noexcept {
+      if (contains(x)) {
+        return false;
+      }
+
+      dense_[size_] = x;
+      sparse_[x] = static_cast<IndexT>(size_);
+      ++size_;
+      return true;
+    }
+
+    /***
+     * erase
+     *
+     * Remove x from the set, returning true iff it was a member. The last member takes the
+     * place of x in the iteration order.
+     * Time: O(1), Space: O(1)
+     */
+    bool erase(IndexT x) noexcept {
+      if (!contains(x)) {
+        return false;
+      }
+
+      const auto last = dense_[--size_];
+      const auto position = sparse_[x];
+      dense_[position] = last;
+      sparse_[last] = position;
+      return true;
+    }
+
+    /***
+     * clear
+     *
+     * Remove every member of the set, without touching the arrays.
+     * Time: O(1), Space: O(1)
+     */
+    void clear() noexcept {
+      size_ = 0;
+    }
+
+    // iterate over the members, in the order they were added, up to erasures
+    [[nodiscard]] const_iterator begin() const noexcept {
+      return dense_.data();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+      return dense_.data() + size_;
+    }
+  };
+}  // namespace jkds::container
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "keyed_index.h"
+
+namespace jkds::container {
+
+  /***
+   * additive_group
+   *
+   * The abelian group (W, +), with identity W{} and inverse -w.
+   */
+  template <typename W>
+  struct additive_group {
+    [[nodiscard]] static constexpr W identity() noexcept {
+      return W{};
+    }
+
+    [[nodiscard]] static constexpr W op(const W& a, const W& b) noexcept {
+      return a + b;
+    }
+
+    [[nodiscard]] static constexpr W inverse(const W& a) noexcept {
+      return -a;
+    }
+  };
+
+  /***
+   * xor_group
+   *
+   * The abelian group (W, ^), where every element is the inverse of itself.
+   */
+  template <typename W>
+  struct xor_group {
+    [[nodiscard]] static constexpr W identity() noexcept {
+      return W{};
+    }
+
+    [[nodiscard]] static constexpr W op(const W& a, const W& b) noexcept {
+      return a ^ b;
+    }
+
+    [[nodiscard]] static constexpr W inverse(const W& a) noexcept {
+      return a;
+    }
+  };
+
+  /***
+   * WeightedDisjointSet
+   *
+   * A Disjoint Set data structure (also known as Union-Find) with potentials, where T is the
+   * type of the elements, and W is the type of the potential differences between them.
+   * Every element x has an unknown potential p(x), and unite(x, y, w) records the constraint
+   * p(x) - p(y) = w, where the difference is computed in the abelian group Group
+   * (additive_group<W> by default, xor_group<W> is also provided).
+   *
+   * Every node stores the potential difference from its parent. find compresses paths by
+   * pointing every visited node to its representative, accumulating the differences along the
+   * way; the union-by-size policy is implemented as well, which results in almost constant
+   * time complexity for every method.
+   * As in DisjointSet<T>, the elements are mapped to the indexes of the nodes by a
+   * detail::KeyedIndex, hence an implementation of std::hash<T> is required.
+   *
+   * Public methods:
+   * - size()
+   * - num_sets()
+   * - add(const T&)
+   * - unite(const T&, const T&, const W&)
+   * - are_connected(const T&, const T&)
+   * - diff(const T&, const T&)
+   */
+  template <typename T, typename W, typename Group = additive_group<W>>
+  class WeightedDisjointSet {
+  private:
+    struct Node {
+      std::size_t parent;
+
+      // number of elements in the set, only meaningful for representatives
+      std::size_t size = 1;
+
+      // p(this) - p(parent)
+      W weight = Group::identity();
+
+      Node(std::size_t parent) : parent(parent) {
+      }
+    };
+    detail::KeyedIndex<T> index_;
+
+    // the nodes are declared after the keys, which size them
+    std::vector<Node> nodes_;
+    std::size_t num_sets_;
+
+    // initialize every item as the parent of itself with size 1
+    [[nodiscard]] static std::vector<Node> init_nodes(std::size_t size) {
+      std::vector<Node> nodes;
+      nodes.reserve(size);
+
+      for (std::size_t i = 0; i < size; ++i) {
+        nodes.emplace_back(i);
+      }
+
+      return nodes;
+    }
+
+    // Return the representative of the set containing the element indexed by i, together with
+    // p(i) - p(representative). Every node on the path is pointed to the representative.
+    [[nodiscard]] std::pair<std::size_t, W> find(std::size_t i) {
+      // first pass: find the representative, and the potential of i relative to it
+      auto root = i;
+      auto potential = Group::identity();
+      while (root != nodes_[root].parent) {
+        potential = Group::op(potential, nodes_[root].weight);
+        root = nodes_[root].parent;
+      }
+
+      // second pass: compress the path, replacing every weight with the accumulated potential
+      auto remaining = potential;
+      while (i != root) {
+        auto& node = nodes_[i];
+        const auto next = node.parent;
+        const auto weight = node.weight;
+
+        node.parent = root;
+        node.weight = remaining;
+        remaining = Group::op(remaining, Group::inverse(weight));
+        i = next;
+      }
+
+      return {root, potential};
+    }
+
+  public:
+    WeightedDisjointSet() = delete;
+
+    // a repeated input is added only once, at the position of its first occurrence
+    explicit WeightedDisjointSet(const std::vector<T>& inputs) :
+        index_(inputs.begin(), inputs.end()), nodes_(init_nodes(index_.size())),
+        num_sets_(index_.size()) {
+    }
+
+    // return the number of elements in the disjoint set
+    [[nodiscard]] std::size_t size() const noexcept {
+      return nodes_.size();
+    }
+
+    // return the number of disjoint sets
+    [[nodiscard]] std::size_t num_sets() const noexcept {
+      return num_sets_;
+    }
+
+    /***
+     * add
+     *
+     * Add a new entry to the disjoint set, returning the index of the resulting node.
+     * Throw std::invalid_argument if x is already an element. If it throws, nothing is added.
+     * Time: O(1) amortized, Space: O(1)
+     */
+    std::size_t add(const T& x) {
+      const auto i = index_.add(x);
+      try {
+        nodes_.emplace_back(i);
+      } catch (...) {
+        index_.pop_back();
+        throw;
+      }
+      ++num_sets_;
+      return i;
+    }
+
+    /***
+     * unite
+     *
+     * Record the constraint p(x) - p(y) = w, merging the sets which contain x and y.
+     * Return false iff x and y were already in the same set, and the constraint contradicts
+     * the ones recorded so far, in which case it is discarded.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    bool unite(const T& x, const T& y, const W& w) {
+      auto [i, potential_x] = find(index_.at(x));
+      auto [j, potential_y] = find(index_.at(y));
+
+      // p(i) - p(j) = p(y) - p(x) + w, since p(x) - p(y) = w
+      auto weight = Group::op(Group::op(potential_y, Group::inverse(potential_x)), w);
+
+      if (i == j) {
+        return weight == Group::identity();
+      }
+
+      // the representative of the smaller set points to the representative of the larger one
+      if (nodes_[i].size < nodes_[j].size) {
+        std::swap(i, j);
+        weight = Group::inverse(weight);
+      }
+
+      // now j is the child, and p(j) - p(i) is the inverse of the weight
+      nodes_[j].parent = i;
+      nodes_[j].weight = Group::inverse(weight);
+      nodes_[i].size += nodes_[j].size;
+      --num_sets_;
+
+      return true;
+    }
+
+    /***
+     * are_connected
+     *
+     * Return true if and only if the given two elements are in the same representative set,
+     * i.e. iff their potential difference is known.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] bool are_connected(const T& x, const T& y) {
+      return find(index_.at(x)).first == find(index_.at(y)).first;
+    }
+
+    /***
+     * diff
+     *
+     * Return p(x) - p(y) if x and y are in the same representative set, std::nullopt otherwise.
+     * Time: O(lg^* n) amortized, Space: O(1)
+     */
+    [[nodiscard]] std::optional<W> diff(const T& x, const T& y) {
+      const auto [i, potential_x] = find(index_.at(x));
+      const auto [j, potential_y] = find(index_.at(y));
+
+      if (i != j) {
+        return std::nullopt;
+      }
+
+      return Group::op(potential_x, Group::inverse(potential_y));
+    }
+  };
+}  // namespace jkds::container
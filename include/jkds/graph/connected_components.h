@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "../container/concurrent_disjoint_set.h"
+#include "../util/parallel.h"
+
+namespace jkds::graph {
+
+  // an undirected edge between two dense vertex ids
+  using edge_t = std::pair<std::size_t, std::size_t>;
+
+  namespace detail {
+
+    // Relabel the sets of a fully compressed disjoint set with the dense ids
+    // [0, number of sets), in increasing order of their smallest element.
+    [[nodiscard]] inline std::vector<std::size_t> dense_labels(
+        jkds::container::ConcurrentDisjointSet& ds, std::size_t num_threads) {
+      const auto n = ds.size();
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+
+      // after compression, the representative of i is a single hop away
+      std::vector<std::size_t> roots(n);
+      jkds::util::parallel_for(0, n, [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+          roots[i] = ds.find(i);
+        }
+      }, num_threads);
+
+      // labels[r] is the dense id of the representative r
+      std::vector<std::size_t> labels(n, unlabeled);
+      std::size_t next_label = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        auto& label = labels[roots[i]];
+        if (label == unlabeled) {
+          label = next_label++;
+        }
+      }
+
+      jkds::util::parallel_for(0, n, [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+          roots[i] = labels[roots[i]];
+        }
+      }, num_threads);
+
+      return roots;
+    }
+  }  // namespace detail
+
+  /***
+   * connected_components
+   *
+   * Compute the connected components of the undirected graph with n vertices and the given
+   * edges, returning the component label of every vertex. Labels are dense, i.e., they span
+   * [0, number of components).
+   *
+   * The edges are processed in parallel by a ConcurrentDisjointSet. An evenly strided sample
+   * of roughly 2n edges is united first, which typically discovers the giant component, and
+   * the trees are then compressed before the remaining edges are united. No edge is skipped:
+   * every remaining edge still costs two finds, but after the compression most of them take a
+   * single hop, as both endpoints usually already point to the same representative.
+   *
+   * Time: O((n + m) lg n / num_threads) expected, Space: O(n)
+   */
+  [[nodiscard]] inline std::vector<std::size_t> connected_components(
+      std::span<const edge_t> edges, std::size_t n,
+      std::size_t num_threads = jkds::util::default_num_threads()) {
+    const auto m = edges.size();
+    jkds::container::ConcurrentDisjointSet ds{n};
+
+    // phase 1: unite the sampled edges, i.e. the ones whose index is a multiple of stride
+    const auto stride = std::max<std::size_t>(1, m / std::max<std::size_t>(1, 2 * n));
+    jkds::util::parallel_for(0, (m + stride - 1) / stride, [&](std::size_t first,
+                                                               std::size_t last) {
+      for (auto k = first; k < last; ++k) {
+        ds.unite(edges[k * stride].first, edges[k * stride].second);
+      }
+    }, num_threads);
+
+    if (stride > 1) {
+      ds.compress(num_threads);
+
+      // phase 2: unite the remaining edges
+      jkds::util::parallel_for(0, m, [&](std::size_t first, std::size_t last) {
+        for (auto k = first; k < last; ++k) {
+          if (k % stride != 0) {
+            ds.unite(edges[k].first, edges[k].second);
+          }
+        }
+      }, num_threads);
+    }
+
+    ds.compress(num_threads);
+    return detail::dense_labels(ds, num_threads);
+  }
+}  // namespace jkds::graph
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../container/rollback_disjoint_set.h"
+#include "connected_components.h"
+
+namespace jkds::graph {
+
+  enum class event_type { add_edge, remove_edge, query };
+
+  /***
+   * Event
+   *
+   * An event of an offline dynamic connectivity problem: depending on type, either the
+   * undirected edge (u, v) is added to or removed from the graph, or the connectivity of the
+   * vertices u and v is queried.
+   */
+  struct Event {
+    event_type type;
+    std::size_t u;
+    std::size_t v;
+  };
+
+  namespace detail {
+
+    // Segment tree over the queries, where every node stores the edges that are alive during
+    // the whole range of queries it covers, in the CSR format.
+    class EdgeSegmentTree {
+    private:
+      std::size_t leaves_;
+      std::vector<std::size_t> offsets_;
+      std::vector<edge_t> edges_;
+
+    public:
+      // intervals[k] = (first query, last query, edge), with the last query excluded
+      EdgeSegmentTree(std::size_t num_queries,
+                      const std::vector<std::pair<std::pair<std::size_t, std::size_t>, edge_t>>&
+                          intervals) :
+          leaves_(1) {
+        while (leaves_ < num_queries) {
+          leaves_ *= 2;
+        }
+
+        // decompose every interval into O(lg q) canonical nodes of the bottom-up segment tree
+        std::vector<std::pair<std::size_t, edge_t>> assignments;
+        for (auto&& [range, edge] : intervals) {
+          for (auto l = range.first + leaves_, r = range.second + leaves_; l < r;
+               l /= 2, r /= 2) {
+            if (l & 1) {
+              assignments.emplace_back(l++, edge);
+            }
+            if (r & 1) {
+              assignments.emplace_back(--r, edge);
+            }
+          }
+        }
+
+        // bucket the edges by node
+        offsets_.assign(2 * leaves_ + 1, 0);
+        for (auto&& [node, _] : assignments) {
+          ++offsets_[node + 1];
+        }
+        for (std::size_t node = 0; node < 2 * leaves_; ++node) {
+          offsets_[node + 1] += offsets_[node];
+        }
+
+        auto cursors = offsets_;
+        edges_.resize(assignments.size());
+        for (auto&& [node, edge] : assignments) {
+          edges_[cursors[node]++] = edge;
+        }
+      }
+
+      [[nodiscard]] std::size_t leaves() const noexcept {
+        return leaves_;
+      }
+
+      [[nodiscard]] std::span<const edge_t> edges_of(std::size_t node) const noexcept {
+        return std::span<const edge_t>(edges_.data() + offsets_[node],
+                                       offsets_[node + 1] - offsets_[node]);
+      }
+    };
+
+    // Visit the subtree rooted at node, which covers the queries in [first, last), answering
+    // the queries at its leaves.
+    inline void answer_queries(const EdgeSegmentTree& tree, std::size_t node, std::size_t first,
+                               std::size_t last, std::span<const Event> queries,
+                               jkds::container::RollbackDisjointSet& ds,
+                               std::vector<bool>& answers) {
+      // the padding leaves of the segment tree don't hold any query
+      if (first >= queries.size()) {
+        return;
+      }
+
+      const auto snapshot = ds.snapshot();
+      for (auto&& [u, v] : tree.edges_of(node)) {
+        ds.unite(u, v);
+      }
+
+      if (last - first == 1) {
+        answers[first] = ds.are_connected(queries[first].u, queries[first].v);
+      } else {
+        const auto middle = first + (last - first) / 2;
+        answer_queries(tree, 2 * node, first, middle, queries, ds, answers);
+        answer_queries(tree, 2 * node + 1, middle, last, queries, ds, answers);
+      }
+
+      ds.rollback(snapshot);
+    }
+  }  // namespace detail
+
+  /***
+   * offline_dynamic_connectivity
+   *
+   * Process a sequence of edge insertions, edge removals and connectivity queries over a graph
+   * with n vertices and no initial edges, returning the answer to every query, in order.
+   * Parallel edges are allowed, and an edge (u, v) is the same as (v, u).
+   * Throw std::invalid_argument if a vertex of any event isn't in [0, n), or if an edge that
+   * isn't present in the graph is removed.
+   *
+   * The lifetime of every edge is an interval of queries, which is stored in O(lg q) nodes of a
+   * segment tree over the queries. A depth-first visit of the segment tree unites the edges of
+   * every node on the way down and rolls them back on the way up, using a RollbackDisjointSet.
+   *
+   * Time: O(m lg q lg n + q lg n), Space: O(n + m lg q), where m is the number of insertions
+   * and q the number of queries.
+   */
+  [[nodiscard]] inline std::vector<bool> offline_dynamic_connectivity(
+      std::size_t n, std::span<const Event> events) {
+    std::vector<Event> queries;
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>, edge_t>> intervals;
+
+    // the first queries that may observe each alive edge
+    std::map<edge_t, std::vector<std::size_t>> alive;
+
+    for (auto&& event : events) {
+      if (event.u >= n || event.v >= n) {
+        throw std::invalid_argument("vertex out of range");
+      }
+      const edge_t edge = std::minmax(event.u, event.v);
+
+      switch (event.type) {
+      case event_type::add_edge:
+        alive[edge].push_back(queries.size());
+        break;
+      case event_type::remove_edge: {
+        auto it = alive.find(edge);
+        if (it == alive.end()) {
+          throw std::invalid_argument("removed edge isn't present");
+        }
+        intervals.push_back({{it->second.back(), queries.size()}, edge});
+        it->second.pop_back();
+        if (it->second.empty()) {
+          alive.erase(it);
+        }
+        break;
+      }
+      case event_type::query:
+        queries.push_back(event);
+        break;
+      }
+    }
+
+    // the edges that are never removed are alive until the last query
+    for (auto&& [edge, first_queries] : alive) {
+      for (auto first_query : first_queries) {
+        intervals.push_back({{first_query, queries.size()}, edge});
+      }
+    }
+
+    std::vector<bool> answers(queries.size());
+    if (queries.empty()) {
+      return answers;
+    }
+
+    detail::EdgeSegmentTree tree{queries.size(), intervals};
+    jkds::container::RollbackDisjointSet ds{n};
+    detail::answer_queries(tree, 1, 0, tree.leaves(), queries, ds, answers);
+    return answers;
+  }
+}  // namespace jkds::graph
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../container/dense_disjoint_set.h"
+#include "../util/parallel.h"
+
+namespace jkds::graph {
+
+  /***
+   * The neighborhood of a grid cell: face connectivity links the cells sharing a side (4 in 2D,
+   * 6 in 3D), full connectivity also links the cells sharing a corner (8 in 2D, 26 in 3D).
+   */
+  enum class grid_connectivity { face, full };
+
+  /***
+   * GridLabels
+   *
+   * A label image, with the same shape of the labeled mask: background cells are labeled 0,
+   * and the cells of the k-th connected component, in order of their first cell in memory
+   * order, are labeled k, for k in [1, num_components].
+   */
+  template <typename Label>
+  struct GridLabels {
+    std::vector<Label> labels;
+    std::size_t num_components;
+  };
+
+  namespace detail {
+
+    // a maximal run [begin, end) of foreground cells within a grid row
+    struct GridRun {
+      std::uint32_t begin;
+      std::uint32_t end;
+    };
+
+    // a row of the grid which may be adjacent to the current one, at the given offsets in the
+    // z and y directions, whose runs touch the current ones if they overlap once extended by
+    // extension cells on both sides
+    struct GridNeighbor {
+      std::ptrdiff_t dz;
+      std::ptrdiff_t dy;
+      std::uint32_t extension;
+    };
+
+    // the previous rows in memory order adjacent to the current one
+    [[nodiscard]] inline std::vector<GridNeighbor> grid_neighbors(grid_connectivity connectivity) {
+      if (connectivity == grid_connectivity::face) {
+        return {{0, -1, 0}, {-1, 0, 0}};
+      }
+      return {{0, -1, 1}, {-1, -1, 1}, {-1, 0, 1}, {-1, 1, 1}};
+    }
+
+    // call on_row(other, extension) for every previous row adjacent to the given one, where
+    // rows are numbered in memory order, i.e. the row (y, z) is z * height + y
+    template <typename RowF>
+    void previous_rows(std::size_t row, std::size_t height,
+                       const std::vector<GridNeighbor>& neighbors, RowF on_row) {
+      const auto z = static_cast<std::ptrdiff_t>(row / height);
+      const auto y = static_cast<std::ptrdiff_t>(row % height);
+
+      for (auto [dz, dy, extension] : neighbors) {
+        if (z + dz >= 0 && y + dy >= 0 && y + dy < static_cast<std::ptrdiff_t>(height)) {
+          on_row(static_cast<std::size_t>((z + dz) * std::ptrdiff_t(height) + y + dy), extension);
+        }
+      }
+    }
+
+    // Return the bitmask of the foreground cells of the block of 64 cells starting at block,
+    // where the bit i is set iff block[i] is nonzero, testing 8 bytes at a time with SWAR.
+    // This is the fallback of the targets without SSE2.
+    [[nodiscard]] inline std::uint64_t foreground_block_swar(const std::uint8_t* block) noexcept {
+      constexpr std::uint64_t low7 = 0x7F7F7F7F7F7F7F7F;
+      constexpr std::uint64_t high = 0x8080808080808080;
+      std::uint64_t mask = 0;
+
+      for (std::size_t k = 0; k < 8; ++k) {
+        std::uint64_t word;
+        std::memcpy(&word, block + 8 * k, sizeof(word));
+
+        // the high bit of every byte is set iff the byte is nonzero, and the 8 high bits are
+        // then gathered into the top byte by a carry-less multiplication
+        const auto nonzero = (((word & low7) + low7) | word) & high;
+        mask |= (((nonzero >> 7) * 0x0102040810204080) >> 56) << (8 * k);
+      }
+      return mask;
+    }
+
+#if defined(__SSE2__)
+    // the same as foreground_block_swar, testing 16 bytes at a time with SSE2
+    [[nodiscard]] inline std::uint64_t foreground_block_sse2(const std::uint8_t* block) noexcept {
+      const auto zero = _mm_setzero_si128();
+      std::uint64_t mask = 0;
+
+      for (std::size_t k = 0; k < 4; ++k) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+        const auto zeros =
+            static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)));
+        mask |= std::uint64_t(~zeros & 0xFFFF) << (16 * k);
+      }
+      return mask;
+    }
+#endif
+
+    // Return the bitmask of the foreground cells among the 64 cells starting at row[x], where
+    // the bit i is set iff row[x + i] is nonzero. The cells past width are background.
+    // Whole blocks are tested with SSE2 where available, and with SWAR otherwise.
+    [[nodiscard]] inline std::uint64_t foreground_mask(const std::uint8_t* row, std::size_t x,
+                                                       std::size_t width) noexcept {
+      if (x + 64 <= width) {
+#if defined(__SSE2__)
+        return foreground_block_sse2(row + x);
+#else
+        return foreground_block_swar(row + x);
+#endif
+      }
+
+      std::uint64_t mask = 0;
+      for (std::size_t i = 0; x + i < width; ++i) {
+        mask |= std::uint64_t(row[x + i] != 0) << i;
+      }
+      return mask;
+    }
+
+    // append the runs of foreground cells of the given row to runs
+    inline void find_runs(const std::uint8_t* row, std::size_t width,
+                          std::vector<GridRun>& runs) {
+      bool open = false;
+      std::uint32_t begin = 0;
+
+      for (std::size_t x = 0; x < width; x += 64) {
+        const auto mask = foreground_mask(row, x, width);
+
+        // skip the blocks that don't end or start a run
+        if (mask == (open ? ~std::uint64_t(0) : 0)) {
+          continue;
+        }
+
+        for (int bit = 0; bit < 64;) {
+          const auto rest = (open ? ~mask : mask) >> bit;
+          if (rest == 0) {
+            break;
+          }
+
+          bit += std::countr_zero(rest);
+          if (open) {
+            runs.push_back({begin, static_cast<std::uint32_t>(x + bit)});
+          } else {
+            begin = static_cast<std::uint32_t>(x + bit);
+          }
+          open = !open;
+        }
+      }
+
+      if (open) {
+        runs.push_back({begin, static_cast<std::uint32_t>(width)});
+      }
+    }
+
+    // call on_touch(i, j) for every pair of runs a[i] and b[j] that touch, once extended by
+    // extension cells on both sides. Both spans are sorted.
+    template <typename TouchF>
+    void touching_runs(std::span<const GridRun> a, std::span<const GridRun> b,
+                       std::uint32_t extension, TouchF on_touch) {
+      std::size_t i = 0;
+      std::size_t j = 0;
+
+      while (i < a.size() && j < b.size()) {
+        if (a[i].begin < b[j].end + extension && b[j].begin < a[i].end + extension) {
+          on_touch(i, j);
+        }
+
+        // the run that ends first can't touch any further run of the other row
+        if (a[i].end < b[j].end) {
+          ++i;
+        } else {
+          ++j;
+        }
+      }
+    }
+
+    // A band of consecutive rows of the grid, labeled on its own: the runs of every row, and
+    // the provisional label of every run, which are dense within the band.
+    struct GridBand {
+      std::size_t first_row;
+      std::vector<GridRun> runs;
+
+      // the runs of the row first_row + r are runs[row_offsets[r], row_offsets[r + 1])
+      std::vector<std::size_t> row_offsets{0};
+      std::vector<std::size_t> labels;
+      std::size_t num_labels = 0;
+
+      [[nodiscard]] std::span<const GridRun> row_runs(std::size_t row) const noexcept {
+        const auto r = row - first_row;
+        return std::span(runs).subspan(row_offsets[r], row_offsets[r + 1] - row_offsets[r]);
+      }
+    };
+
+    // Label the runs of the rows [first_row, last_row) with a DenseDisjointSet, ignoring the
+    // rows outside the band.
+    inline GridBand label_band(const std::uint8_t* mask, std::size_t width, std::size_t height,
+                               std::size_t first_row, std::size_t last_row,
+                               const std::vector<GridNeighbor>& neighbors) {
+      GridBand band;
+      band.first_row = first_row;
+      band.row_offsets.reserve(last_row - first_row + 1);
+
+      // first pass: runs
+      for (auto row = first_row; row < last_row; ++row) {
+        find_runs(mask + row * width, width, band.runs);
+        band.row_offsets.push_back(band.runs.size());
+      }
+
+      jkds::container::DenseDisjointSet ds{band.runs.size()};
+      for (auto row = first_row; row < last_row; ++row) {
+        const auto current = band.row_runs(row);
+        const auto current_offset = band.row_offsets[row - first_row];
+
+        previous_rows(row, height, neighbors, [&](std::size_t other, std::uint32_t extension) {
+          if (other < first_row) {
+            return;
+          }
+
+          const auto other_offset = band.row_offsets[other - first_row];
+          touching_runs(current, band.row_runs(other), extension,
+                        [&](std::size_t i, std::size_t j) {
+                          ds.unite(current_offset + i, other_offset + j);
+                        });
+        });
+      }
+
+      // provisional labels, in order of the first run of every set
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+      std::vector<std::size_t> root_labels(band.runs.size(), unlabeled);
+      band.labels.resize(band.runs.size());
+      for (std::size_t k = 0; k < band.runs.size(); ++k) {
+        auto& label = root_labels[ds.find(k)];
+        if (label == unlabeled) {
+          label = band.num_labels++;
+        }
+        band.labels[k] = label;
+      }
+
+      return band;
+    }
+  }  // namespace detail
+
+  /***
+   * grid_connected_components
+   *
+   * Label the connected components of the foreground (nonzero) cells of a 3D mask of the given
+   * width, height and depth, stored in memory order, i.e. the cell (x, y, z) is
+   * mask[(z * height + y) * width + x]. Return the label image (see GridLabels).
+   *
+   * Cells are never hashed nor visited one by one: the grid is indexed implicitly, and every
+   * row is split into maximal runs of foreground cells, which are found 64 cells at a time with
+   * SIMD comparisons (SSE2, or SWAR on other targets). The first pass unites every run with the
+   * runs it touches in the previous adjacent rows, with a DenseDisjointSet; the second pass
+   * paints every run with the dense label of its set.
+   * The rows are split into num_threads bands, which are labeled independently in parallel.
+   * The provisional labels of the bands are then merged by uniting the runs that touch across
+   * the borders between bands, and the label image is painted in parallel.
+   *
+   * Throw std::invalid_argument if the size of the mask doesn't match its shape, or if the
+   * rows have 2^32 - 1 cells or more, and std::out_of_range if Label is too small for the number
+   * of components. The bands allocate their runs on their own threads; if any of them throws,
+   * e.g. std::bad_alloc, the exception is rethrown on the calling thread.
+   * Time: O(n / num_threads + r lg^* r), where n is the number of cells and r the number of
+   * runs. Space: O(n + r)
+   */
+  template <std::unsigned_integral Label = std::uint32_t>
+  [[nodiscard]] GridLabels<Label> grid_connected_components(
+      std::span<const std::uint8_t> mask, std::size_t width, std::size_t height,
+      std::size_t depth, grid_connectivity connectivity = grid_connectivity::face,
+      std::size_t num_threads = jkds::util::default_num_threads()) {
+    // the number of cells must not wrap around to the size of the mask
+    constexpr auto max_cells = std::numeric_limits<std::size_t>::max();
+    const bool too_many_cells = height != 0 && depth != 0 &&
+                                (width > max_cells / height || width * height > max_cells / depth);
+    if (too_many_cells || mask.size() != width * height * depth) {
+      throw std::invalid_argument("mask size doesn't match its shape");
+    }
+    if (width >= std::numeric_limits<std::uint32_t>::max()) {
+      throw std::invalid_argument("grid rows of 2^32 - 1 cells or more");
+    }
+
+    const auto num_rows = height * depth;
+    if (num_rows == 0) {
+      return {{}, 0};
+    }
+
+    const auto neighbors = detail::grid_neighbors(connectivity);
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, num_rows));
+    const auto chunk = (num_rows + num_threads - 1) / num_threads;
+    const auto num_bands = (num_rows + chunk - 1) / chunk;
+
+    // first pass, within every band
+    std::vector<detail::GridBand> bands(num_bands);
+    jkds::util::parallel_invoke(num_bands, [&](std::size_t b) {
+      bands[b] = detail::label_band(mask.data(), width, height, b * chunk,
+                                    std::min(num_rows, (b + 1) * chunk), neighbors);
+    });
+
+    // merge the provisional labels across the borders between bands
+    std::vector<std::size_t> label_offsets(num_bands + 1, 0);
+    for (std::size_t b = 0; b < num_bands; ++b) {
+      label_offsets[b + 1] = label_offsets[b] + bands[b].num_labels;
+    }
+
+    jkds::container::DenseDisjointSet ds{label_offsets.back()};
+    for (std::size_t b = 1; b < num_bands; ++b) {
+      const auto& band = bands[b];
+
+      // only the first rows of a band may be adjacent to the rows of the previous bands
+      const auto last_row = std::min({num_rows, (b + 1) * chunk, band.first_row + height + 1});
+      for (auto row = band.first_row; row < last_row; ++row) {
+        const auto current_offset = band.row_offsets[row - band.first_row];
+
+        detail::previous_rows(row, height, neighbors, [&](std::size_t other,
+                                                          std::uint32_t extension) {
+          if (other >= band.first_row) {
+            return;
+          }
+
+          const auto o = other / chunk;
+          const auto other_offset = bands[o].row_offsets[other - bands[o].first_row];
+          detail::touching_runs(band.row_runs(row), bands[o].row_runs(other), extension,
+                                [&](std::size_t i, std::size_t j) {
+                                  ds.unite(label_offsets[b] + band.labels[current_offset + i],
+                                           label_offsets[o] + bands[o].labels[other_offset + j]);
+                                });
+        });
+      }
+    }
+
+    // dense labels, in order of the first run of every component, starting from 1
+    constexpr auto unlabeled = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> root_labels(ds.size(), unlabeled);
+    std::vector<Label> final_labels(ds.size());
+    std::size_t num_components = 0;
+
+    for (std::size_t l = 0; l < ds.size(); ++l) {
+      auto& label = root_labels[ds.find(l)];
+      if (label == unlabeled) {
+        if (num_components == std::numeric_limits<Label>::max()) {
+          throw std::out_of_range("too many components for the label type");
+        }
+        label = ++num_components;
+      }
+      final_labels[l] = static_cast<Label>(label);
+    }
+
+    // second pass: paint the runs
+    GridLabels<Label> result{std::vector<Label>(mask.size(), 0), num_components};
+    jkds::util::parallel_invoke(num_bands, [&](std::size_t b) {
+      const auto& band = bands[b];
+      for (std::size_t r = 0; r + 1 < band.row_offsets.size(); ++r) {
+        const auto row = result.labels.data() + (band.first_row + r) * width;
+        for (auto k = band.row_offsets[r]; k < band.row_offsets[r + 1]; ++k) {
+          const auto label = final_labels[label_offsets[b] + band.labels[k]];
+          std::fill(row + band.runs[k].begin, row + band.runs[k].end, label);
+        }
+      }
+    });
+
+    return result;
+  }
+
+  /***
+   * grid_connected_components
+   *
+   * Label the connected components of the foreground (nonzero) cells of a 2D mask of the given
+   * width and height, stored in row-major order, i.e. the cell (x, y) is mask[y * width + x].
+   * See the 3D overload.
+   */
+  template <std::unsigned_integral Label = std::uint32_t>
+  [[nodiscard]] GridLabels<Label> grid_connected_components(
+      std::span<const std::uint8_t> mask, std::size_t width, std::size_t height,
+      grid_connectivity connectivity = grid_connectivity::face,
+      std::size_t num_threads = jkds::util::default_num_threads()) {
+    return grid_connected_components<Label>(mask, width, height, 1, connectivity, num_threads);
+  }
+}  // namespace jkds::graph
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../container/dense_disjoint_set.h"
+
+namespace jkds::graph {
+
+  // the lowest common ancestor of two vertices in different trees of a forest
+  inline constexpr auto no_common_ancestor = static_cast<std::size_t>(-1);
+
+  namespace detail {
+
+    /***
+     * The children of every vertex of a rooted forest, in the CSR format: the children of u are
+     * children[offsets[u], offsets[u + 1]), in increasing order.
+     */
+    struct ForestChildren {
+      std::vector<std::size_t> offsets;
+      std::vector<std::size_t> children;
+      std::vector<std::size_t> roots;
+    };
+
+    // Build the children lists of the forest where parents[u] is the parent of u, and the roots
+    // are their own parents. Throw std::out_of_range if a parent isn't a vertex.
+    [[nodiscard]] inline ForestChildren forest_children(std::span<const std::size_t> parents) {
+      const auto n = parents.size();
+      ForestChildren forest{std::vector<std::size_t>(n + 1, 0), {}, {}};
+
+      for (std::size_t u = 0; u < n; ++u) {
+        if (parents[u] >= n) {
+          throw std::out_of_range("parent out of range");
+        }
+        if (parents[u] == u) {
+          forest.roots.push_back(u);
+        } else {
+          ++forest.offsets[parents[u] + 1];
+        }
+      }
+
+      for (std::size_t u = 0; u < n; ++u) {
+        forest.offsets[u + 1] += forest.offsets[u];
+      }
+
+      auto cursor = forest.offsets;
+      forest.children.resize(n - forest.roots.size());
+      for (std::size_t u = 0; u < n; ++u) {
+        if (parents[u] != u) {
+          forest.children[cursor[parents[u]]++] = u;
+        }
+      }
+
+      return forest;
+    }
+
+    // Visit the forest with an iterative depth-first search, calling on_enter(u, depth) in
+    // preorder and on_exit(u, parent) in postorder, where the parent of a root is itself.
+    // Throw std::invalid_argument if some vertex is unreachable, i.e. the parents have a cycle.
+    template <typename EnterF, typename ExitF>
+    void visit_forest(const ForestChildren& forest, EnterF on_enter, ExitF on_exit) {
+      const auto n = forest.offsets.size() - 1;
+      auto cursor = forest.offsets;
+      std::vector<std::size_t> stack;
+      std::size_t visited = 0;
+
+      for (auto root : forest.roots) {
+        stack.push_back(root);
+        on_enter(root, std::size_t(0));
+        ++visited;
+
+        while (!stack.empty()) {
+          const auto u = stack.back();
+          if (cursor[u] < forest.offsets[u + 1]) {
+            const auto child = forest.children[cursor[u]++];
+            on_enter(child, stack.size());
+            ++visited;
+            stack.push_back(child);
+          } else {
+            stack.pop_back();
+            on_exit(u, stack.empty() ? u : stack.back());
+          }
+        }
+      }
+
+      if (visited != n) {
+        throw std::invalid_argument("parents don't form a forest");
+      }
+    }
+
+    /***
+     * RangeMinimum
+     *
+     * Static range minimum queries in O(1) time and O(n) space: the values are split into
+     * blocks of 64, whose minimums are indexed by a sparse table. Within a block, masks_[i]
+     * holds the positions of the increasing stack of minimums of the block prefix ending at i,
+     * so that the minimum of any range within a block is found with a single bit scan.
+     */
+    class RangeMinimum {
+    private:
+      static constexpr std::size_t block = 64;
+
+      std::vector<std::size_t> values_;
+      std::vector<std::uint64_t> masks_;
+
+      // table_[j][b] is the position of the minimum of the blocks [b, b + 2^j)
+      std::vector<std::vector<std::size_t>> table_;
+
+      [[nodiscard]] std::size_t min_of(std::size_t i, std::size_t j) const noexcept {
+        return values_[j] < values_[i] ? j : i;
+      }
+
+      // position of the minimum of [l, r], within the same block
+      [[nodiscard]] std::size_t in_block(std::size_t l, std::size_t r) const noexcept {
+        const auto mask = masks_[r] & (~std::uint64_t(0) << (l % block));
+        return r - r % block + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+
+    public:
+      explicit RangeMinimum(std::vector<std::size_t> values) :
+          values_(std::move(values)), masks_(values_.size()) {
+        const auto n = values_.size();
+        const auto num_blocks = (n + block - 1) / block;
+        table_.emplace_back(num_blocks);
+
+        for (std::size_t b = 0; b < num_blocks; ++b) {
+          std::uint64_t stack = 0;
+          const auto first = b * block;
+          for (auto i = first; i < std::min(n, first + block); ++i) {
+            while (stack != 0 &&
+                   values_[first + 63 - std::size_t(std::countl_zero(stack))] > values_[i]) {
+              stack &= ~(std::uint64_t(1) << (63 - std::countl_zero(stack)));
+            }
+            stack |= std::uint64_t(1) << (i - first);
+            masks_[i] = stack;
+          }
+          table_[0][b] = first + std::size_t(std::countr_zero(stack));
+        }
+
+        for (std::size_t j = 1; (std::size_t(1) << j) <= num_blocks; ++j) {
+          const auto& previous = table_[j - 1];
+          std::vector<std::size_t> level(num_blocks - (std::size_t(1) << j) + 1);
+          for (std::size_t b = 0; b < level.size(); ++b) {
+            level[b] = min_of(previous[b], previous[b + (std::size_t(1) << (j - 1))]);
+          }
+          table_.push_back(std::move(level));
+        }
+      }
+
+      // return the position of a minimum value in [l, r]
+      [[nodiscard]] std::size_t argmin(std::size_t l, std::size_t r) const noexcept {
+        assert(l <= r && r < values_.size());
+        const auto bl = l / block;
+        const auto br = r / block;
+        if (bl == br) {
+          return in_block(l, r);
+        }
+
+        auto best = min_of(in_block(l, bl * block + block - 1), in_block(br * block, r));
+        if (bl + 1 < br) {
+          const auto j = std::size_t(std::bit_width(br - bl - 1) - 1);
+          best = min_of(best, min_of(table_[j][bl + 1], table_[j][br - (std::size_t(1) << j)]));
+        }
+        return best;
+      }
+    };
+  }  // namespace detail
+
+  /***
+   * offline_lowest_common_ancestors
+   *
+   * Return the lowest common ancestor of every pair of vertices in queries, in the rooted
+   * forest where parents[u] is the parent of u, and every root is its own parent. The answer
+   * is no_common_ancestor if the two vertices are in different trees.
+   *
+   * Tarjan's offline algorithm: a single iterative depth-first search unites every finished
+   * vertex with its parent in a DenseDisjointSet, so that the sets are the subtrees of the
+   * vertices on the current path. When a vertex u is finished, the answer of every query (u, w)
+   * where w is already finished is the ancestor of the set containing w.
+   *
+   * Throw std::out_of_range if a vertex isn't in [0, n), and std::invalid_argument if the
+   * parents have a cycle.
+   * Time: O((n + q) lg^* n), Space: O(n + q)
+   */
+  [[nodiscard]] inline std::vector<std::size_t> offline_lowest_common_ancestors(
+      std::span<const std::size_t> parents,
+      std::span<const std::pair<std::size_t, std::size_t>> queries) {
+    const auto n = parents.size();
+    const auto forest = detail::forest_children(parents);
+
+    // the queries of u are query_lists[query_offsets[u], query_offsets[u + 1]), as pairs of
+    // the other vertex and the index of the query
+    std::vector<std::size_t> query_offsets(n + 1, 0);
+    for (auto [u, w] : queries) {
+      if (u >= n || w >= n) {
+        throw std::out_of_range("query vertex out of range");
+      }
+      ++query_offsets[u + 1];
+      ++query_offsets[w + 1];
+    }
+    for (std::size_t u = 0; u < n; ++u) {
+      query_offsets[u + 1] += query_offsets[u];
+    }
+    std::vector<std::pair<std::size_t, std::size_t>> query_lists(2 * queries.size());
+    {
+      auto cursor = query_offsets;
+      for (std::size_t k = 0; k < queries.size(); ++k) {
+        const auto [u, w] = queries[k];
+        query_lists[cursor[u]++] = {w, k};
+        query_lists[cursor[w]++] = {u, k};
+      }
+    }
+
+    jkds::container::DenseDisjointSet ds{n};
+
+    // ancestor[r] is the vertex on the current path whose subtree is the set represented by r
+    std::vector<std::size_t> ancestor(n);
+
+    // finished_in[u] is the root of the tree of u once u is finished, or none before
+    constexpr auto none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> finished_in(n, none);
+    std::vector<std::size_t> answers(queries.size(), no_common_ancestor);
+    std::size_t tree = 0;
+
+    detail::visit_forest(
+        forest,
+        [&](std::size_t u, std::size_t depth) {
+          if (depth == 0) {
+            tree = u;
+          }
+          ancestor[u] = u;
+        },
+        [&](std::size_t u, std::size_t parent) {
+          finished_in[u] = tree;
+          for (auto k = query_offsets[u]; k < query_offsets[u + 1]; ++k) {
+            const auto [w, id] = query_lists[k];
+            if (finished_in[w] == tree) {
+              answers[id] = ancestor[ds.find(w)];
+            }
+          }
+
+          if (parent != u) {
+            ds.unite(parent, u);
+            ancestor[ds.find(parent)] = parent;
+          }
+        });
+
+    return answers;
+  }
+
+  /***
+   * bridges
+   *
+   * Return the indexes of the bridges of the undirected multigraph with n vertices and the
+   * given edges, in increasing order, where a bridge is an edge whose removal disconnects its
+   * endpoints. Parallel edges and self-loops are never bridges.
+   *
+   * The edges that unite two sets of a DenseDisjointSet form a spanning forest, which is rooted
+   * by an iterative depth-first search. Any other edge (u, w) closes a cycle with the tree path
+   * between u and w, so no edge of that path is a bridge: the lowest common ancestors of all the
+   * non-tree edges are found by offline_lowest_common_ancestors, then every tree path is
+   * contracted in a second DenseDisjointSet, where the topmost vertex of every set is the only
+   * one whose parent edge may still be a bridge. The tree edges left uncontracted are the
+   * bridges.
+   *
+   * Throw std::out_of_range if an endpoint isn't in [0, n).
+   * Time: O((n + m) lg^* n), Space: O(n + m)
+   */
+  [[nodiscard]] inline std::vector<std::size_t> bridges(
+      std::size_t n, std::span<const std::pair<std::size_t, std::size_t>> edges) {
+    const auto m = edges.size();
+
+    // the edges of the spanning forest, whose adjacency lists are
+    // adjacency[offsets[u], offsets[u + 1]), as edge indexes
+    jkds::container::DenseDisjointSet forest{n};
+    std::vector<std::uint8_t> in_forest(m, 0);
+    std::vector<std::size_t> offsets(n + 1, 0);
+    std::vector<std::pair<std::size_t, std::size_t>> cycle_edges;
+    std::vector<std::size_t> cycle_edge_ids;
+
+    for (std::size_t e = 0; e < m; ++e) {
+      const auto [u, w] = edges[e];
+      if (u >= n || w >= n) {
+        throw std::out_of_range("edge vertex out of range");
+      }
+      if (forest.unite(u, w)) {
+        in_forest[e] = 1;
+        ++offsets[u + 1];
+        ++offsets[w + 1];
+      } else {
+        cycle_edges.emplace_back(u, w);
+        cycle_edge_ids.push_back(e);
+      }
+    }
+    for (std::size_t u = 0; u < n; ++u) {
+      offsets[u + 1] += offsets[u];
+    }
+    std::vector<std::size_t> adjacency(offsets[n]);
+    {
+      auto cursor = offsets;
+      for (std::size_t e = 0; e < m; ++e) {
+        if (in_forest[e]) {
+          adjacency[cursor[edges[e].first]++] = e;
+          adjacency[cursor[edges[e].second]++] = e;
+        }
+      }
+    }
+
+    // root every tree at its smallest vertex, where parent_edges[u] is the edge between u and
+    // its parent
+    constexpr auto none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> parents(n, none);
+    std::vector<std::size_t> parent_edges(n, none);
+    std::vector<std::size_t> depths(n, 0);
+    std::vector<std::size_t> stack;
+
+    for (std::size_t root = 0; root < n; ++root) {
+      if (parents[root] != none) {
+        continue;
+      }
+      parents[root] = root;
+      stack.push_back(root);
+
+      while (!stack.empty()) {
+        const auto u = stack.back();
+        stack.pop_back();
+        for (auto k = offsets[u]; k < offsets[u + 1]; ++k) {
+          const auto e = adjacency[k];
+          if (e != parent_edges[u]) {
+            const auto w = edges[e].first == u ? edges[e].second : edges[e].first;
+            parents[w] = u;
+            parent_edges[w] = e;
+            depths[w] = depths[u] + 1;
+            stack.push_back(w);
+          }
+        }
+      }
+    }
+
+    const auto ancestors = offline_lowest_common_ancestors(parents, cycle_edges);
+
+    // top[r] is the topmost vertex of the tree path represented by r
+    jkds::container::DenseDisjointSet paths{n};
+    std::vector<std::size_t> top(n);
+    for (std::size_t u = 0; u < n; ++u) {
+      top[u] = u;
+    }
+    std::vector<std::uint8_t> on_cycle(m, 0);
+
+    for (std::size_t k = 0; k < cycle_edges.size(); ++k) {
+      on_cycle[cycle_edge_ids[k]] = 1;
+      const auto ancestor = ancestors[k];
+      for (auto x : {cycle_edges[k].first, cycle_edges[k].second}) {
+        for (x = top[paths.find(x)]; depths[x] > depths[ancestor];) {
+          on_cycle[parent_edges[x]] = 1;
+          const auto next = top[paths.find(parents[x])];
+          paths.unite(x, parents[x]);
+          top[paths.find(x)] = next;
+          x = next;
+        }
+      }
+    }
+
+    std::vector<std::size_t> result;
+    for (std::size_t e = 0; e < m; ++e) {
+      if (!on_cycle[e]) {
+        result.push_back(e);
+      }
+    }
+    return result;
+  }
+
+  /***
+   * LowestCommonAncestor
+   *
+   * Online lowest common ancestor queries in a static rooted forest, where parents[u] is the
+   * parent of u, and every root is its own parent.
+   * The vertices are numbered in preorder by an iterative depth-first search. For u != v with
+   * u visited first, the vertex of minimum depth visited after u, up to v, is a child of the
+   * lowest common ancestor of u and v: such a vertex is found in O(1) by a range minimum query
+   * over the depths in preorder (a sparse table over blocks of 64 depths, and a bitmask stack
+   * within every block), which is equivalent to, and half the size of, the classic
+   * Euler tour reduction.
+   *
+   * Public methods:
+   * - size()
+   * - depth(std::size_t)
+   * - lca(std::size_t, std::size_t)
+   */
+  class LowestCommonAncestor {
+  private:
+    std::vector<std::size_t> parents_;
+
+    // order_[k] is the k-th vertex in preorder, and position_[u] is the position of u
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> position_;
+    std::vector<std::size_t> depths_;
+    detail::RangeMinimum minimum_;
+
+    // the depths of the vertices in preorder, filling order_, position_ and depths_
+    [[nodiscard]] std::vector<std::size_t> init_order() {
+      const auto n = parents_.size();
+      order_.reserve(n);
+      position_.resize(n);
+      depths_.resize(n);
+      std::vector<std::size_t> depths_in_order;
+      depths_in_order.reserve(n);
+
+      detail::visit_forest(
+          detail::forest_children(parents_),
+          [&](std::size_t u, std::size_t depth) {
+            position_[u] = order_.size();
+            order_.push_back(u);
+            depths_[u] = depth;
+            depths_in_order.push_back(depth);
+          },
+          [](std::size_t, std::size_t) {
+          });
+
+      return depths_in_order;
+    }
+
+  public:
+    LowestCommonAncestor() = delete;
+
+    /***
+     * Preprocess the forest with the given parents.
+     * Throw std::out_of_range if a parent isn't a vertex, and std::invalid_argument if the
+     * parents have a cycle.
+     * Time: O(n), Space: O(n)
+     */
+    explicit LowestCommonAncestor(std::vector<std::size_t> parents) :
+        parents_(std::move(parents)), minimum_(init_order()) {
+    }
+
+    // return the number of vertices
+    [[nodiscard]] std::size_t size() const noexcept {
+      return parents_.size();
+    }
+
+    // return the depth of u, i.e. the number of edges between u and its root
+    [[nodiscard]] std::size_t depth(std::size_t u) const noexcept {
+      assert(u < size());
+      return depths_[u];
+    }
+
+    /***
+     * lca
+     *
+     * Return the lowest common ancestor of u and v, or no_common_ancestor if they're in
+     * different trees.
+     * Time: O(1), Space: O(1)
+     */
+    [[nodiscard]] std::size_t lca(std::size_t u, std::size_t v) const noexcept {
+      assert(u < size() && v < size());
+      if (u == v) {
+        return u;
+      }
+
+      auto l = position_[u];
+      auto r = position_[v];
+      if (l > r) {
+        std::swap(l, r);
+      }
+
+      // a root between u and v means that v isn't in the tree of u
+      const auto child = order_[minimum_.argmin(l + 1, r)];
+      return depths_[child] == 0 ? no_common_ancestor : parents_[child];
+    }
+  };
+}  // namespace jkds::graph
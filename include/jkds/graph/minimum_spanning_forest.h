@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../container/concurrent_disjoint_set.h"
+#include "../container/dense_disjoint_set.h"
+#include "../util/parallel.h"
+#include "../util/radix_sort.h"
+#include "../util/range.h"
+
+namespace jkds::graph {
+
+  // an undirected edge between two dense vertex ids, with an arithmetic weight
+  template <typename W>
+  struct WeightedEdge {
+    std::size_t u;
+    std::size_t v;
+    W weight;
+  };
+
+  enum class mst_algorithm { kruskal, boruvka };
+
+  /***
+   * Merge
+   *
+   * A step of a single-linkage dendrogram: the clusters first and second are merged into a new
+   * cluster of the given size, because of the given edge.
+   * Following the convention of hierarchical clustering libraries, the n vertices are the
+   * singleton clusters [0, n), and the cluster created by the k-th merge is n + k.
+   */
+  template <typename W>
+  struct Merge {
+    std::size_t first;
+    std::size_t second;
+    std::size_t size;
+    WeightedEdge<W> edge;
+  };
+
+  /***
+   * Dendrogram
+   *
+   * The merges performed by single-linkage clustering, in order, and the resulting dense
+   * cluster label of every vertex, numbered in increasing order of their smallest vertex.
+   */
+  template <typename W>
+  struct Dendrogram {
+    std::vector<Merge<W>> merges;
+    std::vector<std::size_t> labels;
+  };
+
+  namespace detail {
+
+    template <typename W>
+    void sort_by_weight(std::vector<WeightedEdge<W>>& edges, std::size_t num_threads) {
+      jkds::util::radix_sort(
+          edges,
+          [](const WeightedEdge<W>& edge) {
+            return jkds::util::radix_key(edge.weight);
+          },
+          num_threads);
+    }
+
+    // atomically replace target with value if value is smaller
+    inline void fetch_min(std::atomic<std::size_t>& target, std::size_t value) noexcept {
+      auto current = target.load(std::memory_order_relaxed);
+      while (value < current &&
+             !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+      }
+    }
+
+    // Boruvka's algorithm on edges sorted by weight: the rank of every edge breaks ties, so every
+    // component selects a unique cheapest outgoing edge. Return the selected edges, sorted.
+    template <typename W>
+    [[nodiscard]] std::vector<WeightedEdge<W>> boruvka(std::size_t n,
+                                                       const std::vector<WeightedEdge<W>>& edges,
+                                                       std::size_t num_threads) {
+      constexpr auto none = static_cast<std::size_t>(-1);
+      jkds::container::ConcurrentDisjointSet ds{n};
+      auto cheapest = std::make_unique<std::atomic<std::size_t>[]>(n);
+      std::vector<std::uint8_t> selected(edges.size(), 0);
+      auto alive = jkds::util::range<std::size_t>(edges.size());
+
+      while (true) {
+        jkds::util::parallel_for(0, n, [&](std::size_t first, std::size_t last) {
+          for (auto r = first; r < last; ++r) {
+            cheapest[r].store(none, std::memory_order_relaxed);
+          }
+        }, num_threads);
+
+        // every component selects its cheapest outgoing edge, and the inner edges are dropped
+        jkds::util::parallel_for(0, alive.size(), [&](std::size_t first, std::size_t last) {
+          for (auto k = first; k < last; ++k) {
+            const auto& edge = edges[alive[k]];
+            const auto ru = ds.find(edge.u);
+            const auto rv = ds.find(edge.v);
+
+            if (ru == rv) {
+              alive[k] = none;
+            } else {
+              fetch_min(cheapest[ru], alive[k]);
+              fetch_min(cheapest[rv], alive[k]);
+            }
+          }
+        }, num_threads);
+
+        // the selected edges form a forest, so each of them merges two components, unless it
+        // was selected by both of its endpoints
+        std::atomic<std::size_t> merges = 0;
+        jkds::util::parallel_for(0, n, [&](std::size_t first, std::size_t last) {
+          std::size_t local_merges = 0;
+          for (auto r = first; r < last; ++r) {
+            const auto k = cheapest[r].load(std::memory_order_relaxed);
+            if (k != none && ds.unite(edges[k].u, edges[k].v)) {
+              selected[k] = 1;
+              ++local_merges;
+            }
+          }
+          merges.fetch_add(local_merges, std::memory_order_relaxed);
+        }, num_threads);
+
+        if (merges.load() == 0) {
+          break;
+        }
+
+        // point every vertex to its representative, so that the next round finds are one hop
+        ds.compress(num_threads);
+        std::erase(alive, none);
+      }
+
+      std::vector<WeightedEdge<W>> forest;
+      for (std::size_t k = 0; k < edges.size(); ++k) {
+        if (selected[k]) {
+          forest.push_back(edges[k]);
+        }
+      }
+
+      return forest;
+    }
+
+    // Kruskal's algorithm on edges sorted by weight, which stops as soon as num_clusters
+    // clusters are left
+    template <typename W>
+    [[nodiscard]] Dendrogram<W> kruskal(std::size_t n, const std::vector<WeightedEdge<W>>& edges,
+                                        std::size_t num_clusters) {
+      jkds::container::DenseDisjointSet ds{n};
+      Dendrogram<W> dendrogram;
+
+      // clusters[r] is the dendrogram cluster whose representative is r
+      auto clusters = jkds::util::range<std::size_t>(n);
+
+      for (auto&& edge : edges) {
+        if (ds.num_sets() <= num_clusters) {
+          break;
+        }
+
+        const auto ru = ds.find(edge.u);
+        const auto rv = ds.find(edge.v);
+        if (ds.unite(ru, rv)) {
+          const auto root = ds.find(ru);
+          dendrogram.merges.push_back({clusters[ru], clusters[rv], ds.set_size(root), edge});
+          clusters[root] = n + dendrogram.merges.size() - 1;
+        }
+      }
+
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+      std::vector<std::size_t> root_labels(n, unlabeled);
+      std::size_t next_label = 0;
+      dendrogram.labels.resize(n);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        auto& label = root_labels[ds.find(i)];
+        if (label == unlabeled) {
+          label = next_label++;
+        }
+        dendrogram.labels[i] = label;
+      }
+
+      return dendrogram;
+    }
+  }  // namespace detail
+
+  /***
+   * minimum_spanning_forest
+   *
+   * Return the edges of a minimum spanning forest of the undirected graph with n vertices and
+   * the given edges, sorted by weight. Ties are broken by the order of the given edges.
+   *
+   * The edges are sorted with a parallel radix sort, then:
+   * - mst_algorithm::kruskal unites them in order with a DenseDisjointSet;
+   * - mst_algorithm::boruvka runs rounds of Boruvka's algorithm, where every component selects
+   *   its cheapest outgoing edge in parallel, and the selected edges are united concurrently
+   *   with a ConcurrentDisjointSet.
+   *
+   * Time: O(m sizeof(W) / num_threads + m lg^* n) with Kruskal, O(m lg^2 n / num_threads) with
+   * Boruvka. Space: O(n + m)
+   */
+  template <typename W>
+  [[nodiscard]] std::vector<WeightedEdge<W>> minimum_spanning_forest(
+      std::size_t n, std::vector<WeightedEdge<W>> edges,
+      mst_algorithm algorithm = mst_algorithm::kruskal,
+      std::size_t num_threads = jkds::util::default_num_threads()) {
+    detail::sort_by_weight(edges, num_threads);
+
+    if (algorithm == mst_algorithm::boruvka) {
+      return detail::boruvka(n, edges, num_threads);
+    }
+
+    auto merges = detail::kruskal(n, edges, 1).merges;
+    std::vector<WeightedEdge<W>> forest;
+    forest.reserve(merges.size());
+
+    for (auto&& merge : merges) {
+      forest.push_back(merge.edge);
+    }
+
+    return forest;
+  }
+
+  /***
+   * single_linkage
+   *
+   * Cluster the n vertices of an undirected weighted graph with single-linkage hierarchical
+   * clustering, stopping as soon as num_clusters clusters are left (or no edge is left).
+   * Return the dendrogram of the merges, and the cluster labels at the time of the stop.
+   *
+   * Single-linkage merges follow the edges of a minimum spanning forest in order of weight.
+   * With mst_algorithm::kruskal, the sorted edges are processed by a DenseDisjointSet until
+   * enough merges are performed. With mst_algorithm::boruvka, the minimum spanning forest is
+   * computed in parallel first, and only its edges are then processed in order.
+   *
+   * Time: see minimum_spanning_forest, Space: O(n + m)
+   */
+  template <typename W>
+  [[nodiscard]] Dendrogram<W> single_linkage(
+      std::size_t n, std::vector<WeightedEdge<W>> edges, std::size_t num_clusters = 1,
+      mst_algorithm algorithm = mst_algorithm::kruskal,
+      std::size_t num_threads = jkds::util::default_num_threads()) {
+    detail::sort_by_weight(edges, num_threads);
+
+    if (algorithm == mst_algorithm::boruvka) {
+      return detail::kruskal(n, detail::boruvka(n, edges, num_threads), num_clusters);
+    }
+
+    return detail::kruskal(n, edges, num_clusters);
+  }
+}  // namespace jkds::graph
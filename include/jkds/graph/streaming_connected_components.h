@@ -0,0 +1,186 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../container/dense_disjoint_set.h"
+#include "../util/mapped_file.h"
+
+namespace jkds::graph {
+
+  enum class edge_file_access { mapped, chunked };
+
+  /***
+   * StreamingStats
+   *
+   * The outcome of stream_connected_components: the number of edges read, the number of
+   * connected components found, and the wall-clock time spent, from opening the edge file to
+   * writing the last label.
+   */
+  struct StreamingStats {
+    std::size_t num_edges;
+    std::size_t num_components;
+    double seconds;
+
+    [[nodiscard]] double edges_per_second() const noexcept {
+      return seconds > 0 ? double(num_edges) / seconds : 0.0;
+    }
+  };
+
+  namespace detail {
+
+    // number of edges read ahead of the current one, whose endpoints are prefetched
+    constexpr std::size_t stream_prefetch_distance = 16;
+
+    // size of the blocks of the file that are read at once in edge_file_access::chunked mode,
+    // a multiple of the page size
+    constexpr std::size_t stream_chunk_bytes = std::size_t(1) << 22;
+
+    // unite the endpoints of the edges stored in ids as u0, v0, u1, v1, ..., prefetching the
+    // nodes of the endpoints a few edges ahead
+    template <typename V>
+    void unite_stream(jkds::container::DenseDisjointSet& ds, std::span<const V> ids) {
+      const auto n = ds.size();
+      const auto num_ids = ids.size();
+
+      for (std::size_t k = 0; k < num_ids; k += 2) {
+        const auto ahead = k + 2 * stream_prefetch_distance;
+        if (ahead < num_ids) {
+          ds.prefetch(static_cast<std::size_t>(ids[ahead]));
+          ds.prefetch(static_cast<std::size_t>(ids[ahead + 1]));
+        }
+
+        const auto u = static_cast<std::size_t>(ids[k]);
+        const auto v = static_cast<std::size_t>(ids[k + 1]);
+        if (u >= n || v >= n) {
+          throw std::out_of_range("edge endpoint out of range");
+        }
+        ds.unite(u, v);
+      }
+    }
+
+    // write the dense component label of every vertex to the given path, as an array of V,
+    // where components are numbered in increasing order of their smallest vertex
+    template <typename V>
+    void write_labels(jkds::container::DenseDisjointSet& ds,
+                      const std::filesystem::path& labels_path) {
+      std::ofstream out(labels_path, std::ios::binary | std::ios::trunc);
+      if (!out) {
+        throw std::runtime_error("cannot open " + labels_path.string());
+      }
+
+      const auto n = ds.size();
+      constexpr auto unlabeled = static_cast<std::size_t>(-1);
+      std::vector<std::size_t> root_labels(n, unlabeled);
+      std::size_t next_label = 0;
+
+      std::vector<V> buffer;
+      buffer.reserve(stream_chunk_bytes / sizeof(V));
+
+      for (std::size_t i = 0; i < n; ++i) {
+        auto& label = root_labels[ds.find(i)];
+        if (label == unlabeled) {
+          label = next_label++;
+        }
+        buffer.push_back(static_cast<V>(label));
+
+        if (buffer.size() == buffer.capacity() || i + 1 == n) {
+          out.write(reinterpret_cast<const char*>(buffer.data()),
+                    std::streamsize(buffer.size() * sizeof(V)));
+          buffer.clear();
+        }
+      }
+
+      if (!out) {
+        throw std::runtime_error("cannot write " + labels_path.string());
+      }
+    }
+
+    template <typename V>
+    std::size_t unite_chunked(jkds::container::DenseDisjointSet& ds,
+                              const std::filesystem::path& edges_path) {
+      std::ifstream in(edges_path, std::ios::binary);
+      if (!in) {
+        throw std::runtime_error("cannot open " + edges_path.string());
+      }
+
+      std::vector<V> buffer(stream_chunk_bytes / sizeof(V));
+      std::size_t num_edges = 0;
+
+      while (in) {
+        in.read(reinterpret_cast<char*>(buffer.data()),
+                std::streamsize(buffer.size() * sizeof(V)));
+        const auto bytes = static_cast<std::size_t>(in.gcount());
+        if (bytes % (2 * sizeof(V)) != 0) {
+          throw std::runtime_error("truncated edge file " + edges_path.string());
+        }
+
+        const auto num_ids = bytes / sizeof(V);
+        unite_stream<V>(ds, std::span<const V>(buffer.data(), num_ids));
+        num_edges += num_ids / 2;
+      }
+
+      return num_edges;
+    }
+
+    template <typename V>
+    std::size_t unite_mapped(jkds::container::DenseDisjointSet& ds,
+                             const std::filesystem::path& edges_path) {
+#if JKDS_HAS_MMAP
+      jkds::util::MappedFile file{edges_path};
+      if (file.size() % (2 * sizeof(V)) != 0) {
+        throw std::runtime_error("truncated edge file " + edges_path.string());
+      }
+
+      file.advise_sequential();
+      const auto ids = file.as<V>();
+      unite_stream<V>(ds, ids);
+      return ids.size() / 2;
+#else
+      return unite_chunked<V>(ds, edges_path);
+#endif
+    }
+  }  // namespace detail
+
+  /***
+   * stream_connected_components
+   *
+   * Compute the connected components of an undirected graph with n vertices, whose edges are
+   * stored in the binary file at edges_path as consecutive pairs of native-endian V, and write
+   * the dense component label of every vertex to the binary file at labels_path, as an array
+   * of n native-endian V. Components are numbered in increasing order of their smallest vertex.
+   *
+   * The edge file is never loaded in memory as a whole: with edge_file_access::mapped it's
+   * memory mapped and scanned sequentially (falling back to chunked reads where mmap isn't
+   * available), with edge_file_access::chunked it's read in blocks of a few MiB. The edges are
+   * fed to a DenseDisjointSet, prefetching the nodes of the endpoints of the upcoming edges, so
+   * the memory footprint is O(n), regardless of the number of edges.
+   * Throw std::out_of_range if an endpoint isn't in [0, n), and std::runtime_error (or
+   * std::system_error) if a file can't be read or written, or the edge file is truncated.
+   *
+   * Time: O(m lg^* n + n), Space: O(n)
+   */
+  template <std::unsigned_integral V = std::uint64_t>
+  StreamingStats stream_connected_components(const std::filesystem::path& edges_path,
+                                             std::size_t n,
+                                             const std::filesystem::path& labels_path,
+                                             edge_file_access access = edge_file_access::mapped) {
+    const auto start = std::chrono::steady_clock::now();
+    jkds::container::DenseDisjointSet ds{n};
+
+    const auto num_edges = access == edge_file_access::mapped
+                               ? detail::unite_mapped<V>(ds, edges_path)
+                               : detail::unite_chunked<V>(ds, edges_path);
+    detail::write_labels<V>(ds, labels_path);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {num_edges, ds.num_sets(), elapsed.count()};
+  }
+}  // namespace jkds::graph
@@ -0,0 +1,584 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "../container/byte_set.h"
+#include "../container/sparse_byte_set.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define JKDS_HAS_BYTE_SCAN_SIMD 1
+#else
+#define JKDS_HAS_BYTE_SCAN_SIMD 0
+#endif
+
+namespace jkds::util {
+
+  // the instruction sets a buffer can be scanned with, from the slowest to the fastest
+  enum class byte_scan_isa { scalar, ssse3, avx2 };
+
+  /***
+   * best_byte_scan_isa
+   *
+   * Return the fastest instruction set supported by the running processor. The SSSE3 and AVX2
+   * kernels are compiled with function target attributes, so they don't need any compiler
+   * flag, and they're selected at runtime. JKDS_HAS_BYTE_SCAN_SIMD is defined as 1 on the x86
+   * targets where they're available, and as 0 elsewhere, where only the scalar loop is used.
+   */
+  [[nodiscard]] inline byte_scan_isa best_byte_scan_isa() noexcept {
+#if JKDS_HAS_BYTE_SCAN_SIMD
+    static const auto isa = __builtin_cpu_supports("avx2")    ? byte_scan_isa::avx2
+                            : __builtin_cpu_supports("ssse3") ? byte_scan_isa::ssse3
+                                                              : byte_scan_isa::scalar;
+    return isa;
+#else
+    return byte_scan_isa::scalar;
+#endif
+  }
+
+  namespace detail {
+
+    /***
+     * The lookup tables of a ByteClass.
+     * If shufti is true, the byte b is a member iff low[b & 15] & high[b >> 4] is nonzero:
+     * every bit is a bucket of bytes sharing the same set of low nibbles, and there can be up
+     * to 8 buckets. Otherwise, the bit (b >> 4) & 7 of low[b & 15] (if b < 128) or of
+     * high[b & 15] (if b >= 128) is set iff b is a member, which fits any class of bytes.
+     * Either way, a 16-byte shuffle looks up 16 or 32 bytes at once.
+     */
+    struct ByteClassTables {
+      // the bit b % 64 of bits[b / 64] is set iff the byte b is a member
+      std::array<std::uint64_t, 4> bits{};
+      alignas(16) std::array<std::uint8_t, 16> low{};
+      alignas(16) std::array<std::uint8_t, 16> high{};
+      bool shufti = true;
+    };
+
+    [[nodiscard]] constexpr bool byte_class_contains(const ByteClassTables& tables,
+                                                     std::uint8_t byte) noexcept {
+      return (tables.bits[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    [[nodiscard]] inline std::size_t find_first_of_scalar(const ByteClassTables& tables,
+                                                          const std::uint8_t* bytes,
+                                                          std::size_t from, std::size_t size) {
+      for (auto i = from; i < size; ++i) {
+        if (byte_class_contains(tables, bytes[i])) {
+          return i;
+        }
+      }
+      return std::string_view::npos;
+    }
+
+    // return the bitmask of the members among the up to 64 bytes in [from, size)
+    [[nodiscard]] inline std::uint64_t match_mask_scalar(const ByteClassTables& tables,
+                                                         const std::uint8_t* bytes,
+                                                         std::size_t from, std::size_t size) {
+      std::uint64_t mask = 0;
+      for (auto i = from; i < size && i < from + 64; ++i) {
+        mask |= std::uint64_t(byte_class_contains(tables, bytes[i])) << (i - from);
+      }
+      return mask;
+    }
+
+    inline void match_bitmap_scalar(const ByteClassTables& tables, const std::uint8_t* bytes,
+                                    std::size_t size, std::uint64_t* out) {
+      for (std::size_t i = 0; i < size; i += 64) {
+        out[i / 64] = match_mask_scalar(tables, bytes, i, size);
+      }
+    }
+
+#if JKDS_HAS_BYTE_SCAN_SIMD
+    // return a vector whose bytes are nonzero iff the corresponding input bytes are members
+    [[gnu::target("ssse3")]] inline __m128i classify_ssse3(__m128i input, __m128i low,
+                                                           __m128i high, bool shufti) {
+      const auto nibble = _mm_set1_epi8(0x0F);
+      const auto high_nibbles = _mm_and_si128(_mm_srli_epi16(input, 4), nibble);
+      if (shufti) {
+        return _mm_and_si128(_mm_shuffle_epi8(low, _mm_and_si128(input, nibble)),
+                             _mm_shuffle_epi8(high, high_nibbles));
+      }
+
+      // a shuffle yields zero where the index has its top bit set
+      const auto rows = _mm_or_si128(
+          _mm_shuffle_epi8(low, input),
+          _mm_shuffle_epi8(high, _mm_xor_si128(input, _mm_set1_epi8(-128))));
+      const auto bit = _mm_shuffle_epi8(
+          _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+          _mm_and_si128(high_nibbles, _mm_set1_epi8(0x07)));
+      return _mm_and_si128(rows, bit);
+    }
+
+    [[gnu::target("ssse3")]] inline std::uint64_t match_mask_ssse3(const std::uint8_t* bytes,
+                                                                   __m128i low, __m128i high,
+                                                                   bool shufti) {
+      const auto zero = _mm_setzero_si128();
+      std::uint64_t mask = 0;
+      for (std::size_t k = 0; k < 4; ++k) {
+        const auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16 * k));
+        const auto misses = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(classify_ssse3(input, low, high, shufti), zero)));
+        mask |= std::uint64_t(~misses & 0xFFFF) << (16 * k);
+      }
+      return mask;
+    }
+
+    [[gnu::target("ssse3")]] inline std::size_t find_first_of_ssse3(
+        const ByteClassTables& tables, const std::uint8_t* bytes, std::size_t from,
+        std::size_t size) {
+      const auto low = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.low.data()));
+      const auto high = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.high.data()));
+      auto i = from;
+      for (; i + 64 <= size; i += 64) {
+        const auto mask = match_mask_ssse3(bytes + i, low, high, tables.shufti);
+        if (mask != 0) {
+          return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+      }
+      return find_first_of_scalar(tables, bytes, i, size);
+    }
+
+    [[gnu::target("ssse3")]] inline std::uint64_t match_mask_at_ssse3(
+        const ByteClassTables& tables, const std::uint8_t* bytes, std::size_t from,
+        std::size_t size) {
+      if (from + 64 > size) {
+        return match_mask_scalar(tables, bytes, from, size);
+      }
+      return match_mask_ssse3(
+          bytes + from, _mm_load_si128(reinterpret_cast<const __m128i*>(tables.low.data())),
+          _mm_load_si128(reinterpret_cast<const __m128i*>(tables.high.data())), tables.shufti);
+    }
+
+    [[gnu::target("ssse3")]] inline void match_bitmap_ssse3(const ByteClassTables& tables,
+                                                            const std::uint8_t* bytes,
+                                                            std::size_t size,
+                                                            std::uint64_t* out) {
+      const auto low = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.low.data()));
+      const auto high = _mm_load_si128(reinterpret_cast<const __m128i*>(tables.high.data()));
+      std::size_t i = 0;
+      for (; i + 64 <= size; i += 64) {
+        out[i / 64] = match_mask_ssse3(bytes + i, low, high, tables.shufti);
+      }
+      if (i < size) {
+        out[i / 64] = match_mask_scalar(tables, bytes, i, size);
+      }
+    }
+
+    // the AVX2 shuffles work within each 128-bit lane, so the tables are broadcast to both
+    [[gnu::target("avx2")]] inline __m256i classify_avx2(__m256i input, __m256i low,
+                                                         __m256i high, bool shufti) {
+      const auto nibble = _mm256_set1_epi8(0x0F);
+      const auto high_nibbles = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble);
+      if (shufti) {
+        return _mm256_and_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(input, nibble)),
+                                _mm256_shuffle_epi8(high, high_nibbles));
+      }
+
+      const auto rows = _mm256_or_si256(
+          _mm256_shuffle_epi8(low, input),
+          _mm256_shuffle_epi8(high, _mm256_xor_si256(input, _mm256_set1_epi8(-128))));
+      const auto bit = _mm256_shuffle_epi8(
+          _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4,
+                           8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128),
+          _mm256_and_si256(high_nibbles, _mm256_set1_epi8(0x07)));
+      return _mm256_and_si256(rows, bit);
+    }
+
+    [[gnu::target("avx2")]] inline std::uint64_t match_mask_avx2(const std::uint8_t* bytes,
+                                                                 __m256i low, __m256i high,
+                                                                 bool shufti) {
+      const auto zero = _mm256_setzero_si256();
+      const auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+      const auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + 32));
+      const auto first_misses = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+          _mm256_cmpeq_epi8(classify_avx2(first, low, high, shufti), zero)));
+      const auto second_misses = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+          _mm256_cmpeq_epi8(classify_avx2(second, low, high, shufti), zero)));
+      return ~(std::uint64_t(second_misses) << 32 | first_misses);
+    }
+
+    [[gnu::target("avx2")]] inline std::size_t find_first_of_avx2(const ByteClassTables& tables,
+                                                                  const std::uint8_t* bytes,
+                                                                  std::size_t from,
+                                                                  std::size_t size) {
+      const auto low = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(tables.low.data())));
+      const auto high = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(tables.high.data())));
+      auto i = from;
+      for (; i + 64 <= size; i += 64) {
+        const auto mask = match_mask_avx2(bytes + i, low, high, tables.shufti);
+        if (mask != 0) {
+          return i + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+      }
+      return find_first_of_scalar(tables, bytes, i, size);
+    }
+
+    [[gnu::target("avx2")]] inline std::uint64_t match_mask_at_avx2(const ByteClassTables& tables,
+                                                                    const std::uint8_t* bytes,
+                                                                    std::size_t from,
+                                                                    std::size_t size) {
+      if (from + 64 > size) {
+        return match_mask_scalar(tables, bytes, from, size);
+      }
+      return match_mask_avx2(bytes + from,
+                             _mm256_broadcastsi128_si256(_mm_load_si128(
+                                 reinterpret_cast<const __m128i*>(tables.low.data()))),
+                             _mm256_broadcastsi128_si256(_mm_load_si128(
+                                 reinterpret_cast<const __m128i*>(tables.high.data()))),
+                             tables.shufti);
+    }
+
+    [[gnu::target("avx2")]] inline void match_bitmap_avx2(const ByteClassTables& tables,
+                                                          const std::uint8_t* bytes,
+                                                          std::size_t size, std::uint64_t* out) {
+      const auto low = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(tables.low.data())));
+      const auto high = _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(tables.high.data())));
+      std::size_t i = 0;
+      for (; i + 64 <= size; i += 64) {
+        out[i / 64] = match_mask_avx2(bytes + i, low, high, tables.shufti);
+      }
+      if (i < size) {
+        out[i / 64] = match_mask_scalar(tables, bytes, i, size);
+      }
+    }
+#endif
+  }  // namespace detail
+
+  /***
+   * ByteClass
+   *
+   * A class of bytes, such as the delimiters of a tokenizer, given as a SparseByteSet, a
+   * ByteSet or a string, compiled into the nibble lookup tables of a SIMD classifier (the
+   * "shufti" technique of Hyperscan): the bytes whose high nibbles share the same set of low
+   * nibbles are grouped into one of 8 buckets, so that two 16-byte shuffles classify 16 bytes
+   * (SSSE3) or 32 bytes (AVX2) at once. The classes that
+   * need more than 8 buckets use a third shuffle instead, and the scalar loop uses a 256-bit
+   * bitmap. A ByteClass is compiled once, possibly at compile time since it's constexpr, and
+   * then scanned with find_first_of, match_mask, match_bitmap and split_by.
+   *
+   * Public methods:
+   * - size()
+   * - contains(uint8_t)
+   * - tables()
+   */
+  class ByteClass {
+  private:
+    detail::ByteClassTables tables_;
+
+    template <typename It>
+    constexpr void compile(It first, It last) {
+      // rows[h] is the set of low nibbles of the members whose high nibble is h
+      std::array<std::uint16_t, 16> rows{};
+      for (; first != last; ++first) {
+        const auto byte = static_cast<std::uint8_t>(*first);
+        tables_.bits[byte >> 6] |= std::uint64_t(1) << (byte & 63);
+        rows[byte >> 4] |= static_cast<std::uint16_t>(1 << (byte & 15));
+      }
+
+      std::array<std::uint16_t, 8> buckets{};
+      std::size_t num_buckets = 0;
+      for (std::size_t h = 0; h < 16 && tables_.shufti; ++h) {
+        if (rows[h] == 0) {
+          continue;
+        }
+
+        std::size_t k = 0;
+        while (k < num_buckets && buckets[k] != rows[h]) {
+          ++k;
+        }
+        if (k == num_buckets) {
+          if (num_buckets == buckets.size()) {
+            tables_.shufti = false;
+            break;
+          }
+          buckets[num_buckets++] = rows[h];
+          for (std::size_t l = 0; l < 16; ++l) {
+            if ((rows[h] >> l) & 1) {
+              tables_.low[l] |= static_cast<std::uint8_t>(1 << k);
+            }
+          }
+        }
+        tables_.high[h] |= static_cast<std::uint8_t>(1 << k);
+      }
+
+      if (!tables_.shufti) {
+        tables_.low.fill(0);
+        tables_.high.fill(0);
+        for (std::size_t h = 0; h < 16; ++h) {
+          auto& table = h < 8 ? tables_.low : tables_.high;
+          for (std::size_t l = 0; l < 16; ++l) {
+            if ((rows[h] >> l) & 1) {
+              table[l] |= static_cast<std::uint8_t>(1 << (h & 7));
+            }
+          }
+        }
+      }
+    }
+
+  public:
+    ByteClass() = delete;
+
+    /***
+     * Compile the bytes in the given set.
+     * Time: O(bytes.size()), Space: O(1)
+     */
+    constexpr explicit ByteClass(const jkds::container::SparseByteSet& bytes) {
+      compile(bytes.begin(), bytes.end());
+    }
+
+    /***
+     * Compile the bytes in the given set.
+     * Time: O(bytes.size()), Space: O(1)
+     */
+    constexpr explicit ByteClass(const jkds::container::ByteSet& bytes) {
+      compile(bytes.begin(), bytes.end());
+    }
+
+    /***
+     * Compile the bytes of the given string, e.g. ByteClass(" \t\n").
+     * Time: O(bytes.size()), Space: O(1)
+     */
+    constexpr explicit ByteClass(std::string_view bytes) {
+      compile(bytes.begin(), bytes.end());
+    }
+
+    // return the number of bytes in the class
+    [[nodiscard]] constexpr std::size_t size() const noexcept {
+      std::size_t count = 0;
+      for (auto word : tables_.bits) {
+        count += static_cast<std::size_t>(std::popcount(word));
+      }
+      return count;
+    }
+
+    // return true iff the given byte is in the class
+    [[nodiscard]] constexpr bool contains(std::uint8_t byte) const noexcept {
+      return detail::byte_class_contains(tables_, byte);
+    }
+
+    // return the compiled lookup tables
+    [[nodiscard]] constexpr const detail::ByteClassTables& tables() const noexcept {
+      return tables_;
+    }
+  };
+
+  /***
+   * find_first_of
+   *
+   * Return the position of the first byte of buffer at or after from which is in byte_class,
+   * or std::string_view::npos if there's none. Every block of 64 bytes is classified with the
+   * given instruction set, which must be supported by the running processor, and the last
+   * partial block is scanned one byte at a time.
+   * Time: O(n), Space: O(1)
+   */
+  [[nodiscard]] inline std::size_t find_first_of(std::string_view buffer,
+                                                 const ByteClass& byte_class,
+                                                 std::size_t from = 0,
+                                                 byte_scan_isa isa = best_byte_scan_isa()) {
+    const auto bytes = reinterpret_cast<const std::uint8_t*>(buffer.data());
+    const auto& tables = byte_class.tables();
+
+    switch (isa) {
+#if JKDS_HAS_BYTE_SCAN_SIMD
+      case byte_scan_isa::avx2:
+        return detail::find_first_of_avx2(tables, bytes, from, buffer.size());
+      case byte_scan_isa::ssse3:
+        return detail::find_first_of_ssse3(tables, bytes, from, buffer.size());
+#endif
+      default:
+        return detail::find_first_of_scalar(tables, bytes, from, buffer.size());
+    }
+  }
+
+  /***
+   * match_mask
+   *
+   * Return the bitmask of the bytes of buffer in [from, from + 64) which are in byte_class,
+   * where the bit i is set iff buffer[from + i] is a member. The bits past the end of the
+   * buffer are cleared.
+   * Time: O(1), Space: O(1)
+   */
+  [[nodiscard]] inline std::uint64_t match_mask(std::string_view buffer,
+                                                const ByteClass& byte_class, std::size_t from,
+                                                byte_scan_isa isa = best_byte_scan_isa()) {
+    const auto bytes = reinterpret_cast<const std::uint8_t*>(buffer.data());
+    const auto& tables = byte_class.tables();
+
+    switch (isa) {
+#if JKDS_HAS_BYTE_SCAN_SIMD
+      case byte_scan_isa::avx2:
+        return detail::match_mask_at_avx2(tables, bytes, from, buffer.size());
+      case byte_scan_isa::ssse3:
+        return detail::match_mask_at_ssse3(tables, bytes, from, buffer.size());
+#endif
+      default:
+        return detail::match_mask_scalar(tables, bytes, from, buffer.size());
+    }
+  }
+
+  /***
+   * match_bitmap
+   *
+   * Write the positions of the bytes of buffer which are in byte_class as a bitmap, where the
+   * bit i % 64 of out[i / 64] is set iff buffer[i] is a member. The bits past the end of the
+   * buffer are cleared. Throw std::invalid_argument if out has less than ceil(n / 64) words.
+   * Time: O(n), Space: O(1)
+   */
+  inline void match_bitmap(std::string_view buffer, const ByteClass& byte_class,
+                           std::span<std::uint64_t> out,
+                           byte_scan_isa isa = best_byte_scan_isa()) {
+    if (out.size() < (buffer.size() + 63) / 64) {
+      throw std::invalid_argument("match_bitmap: output too small");
+    }
+
+    const auto bytes = reinterpret_cast<const std::uint8_t*>(buffer.data());
+    const auto& tables = byte_class.tables();
+
+    switch (isa) {
+#if JKDS_HAS_BYTE_SCAN_SIMD
+      case byte_scan_isa::avx2:
+        detail::match_bitmap_avx2(tables, bytes, buffer.size(), out.data());
+        break;
+      case byte_scan_isa::ssse3:
+        detail::match_bitmap_ssse3(tables, bytes, buffer.size(), out.data());
+        break;
+#endif
+      default:
+        detail::match_bitmap_scalar(tables, bytes, buffer.size(), out.data());
+    }
+  }
+
+  // return the bitmap of the positions of the bytes of buffer which are in byte_class
+  [[nodiscard]] inline std::vector<std::uint64_t> match_bitmap(
+      std::string_view buffer, const ByteClass& byte_class,
+      byte_scan_isa isa = best_byte_scan_isa()) {
+    std::vector<std::uint64_t> out((buffer.size() + 63) / 64);
+    match_bitmap(buffer, byte_class, out, isa);
+    return out;
+  }
+
+  /***
+   * ByteSplitView
+   *
+   * A forward range over the tokens of a buffer separated by the bytes of a ByteClass, as
+   * string views into the buffer. As with std::views::split, consecutive delimiters yield
+   * empty tokens, a trailing delimiter yields a trailing empty token, and an empty buffer has
+   * no tokens. The buffer must outlive the view. Returned by split_by.
+   *
+   * Public methods:
+   * - begin()
+   * - end()
+   */
+  class ByteSplitView {
+  private:
+    std::string_view buffer_;
+    ByteClass delimiters_;
+    byte_scan_isa isa_;
+
+  public:
+    class iterator {
+    private:
+      const ByteSplitView* view_ = nullptr;
+
+      // the current token is [first_, last_), and first_ is npos past the last token
+      std::size_t first_ = std::string_view::npos;
+      std::size_t last_ = std::string_view::npos;
+
+      // the delimiters after last_ in the 64-byte block starting at block_
+      std::size_t block_ = 0;
+      std::uint64_t mask_ = 0;
+
+      // every delimiter ends exactly one token, so they're taken in order from the block masks
+      void find_last() {
+        const auto size = view_->buffer_.size();
+        while (mask_ == 0) {
+          block_ += 64;
+          if (block_ >= size) {
+            last_ = size;
+            return;
+          }
+          mask_ = match_mask(view_->buffer_, view_->delimiters_, block_, view_->isa_);
+        }
+
+        last_ = block_ + static_cast<std::size_t>(std::countr_zero(mask_));
+        mask_ &= mask_ - 1;
+      }
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      iterator(const ByteSplitView* view, std::size_t first) : view_(view), first_(first) {
+        if (first_ != std::string_view::npos) {
+          mask_ = match_mask(view_->buffer_, view_->delimiters_, 0, view_->isa_);
+          find_last();
+        }
+      }
+
+      [[nodiscard]] std::string_view operator*() const {
+        return view_->buffer_.substr(first_, last_ - first_);
+      }
+
+      iterator& operator++() {
+        if (last_ == view_->buffer_.size()) {
+          first_ = std::string_view::npos;
+        } else {
+          first_ = last_ + 1;
+          find_last();
+        }
+        return *this;
+      }
+
+      iterator operator++(int) {
+        auto previous = *this;
+        ++*this;
+        return previous;
+      }
+
+      [[nodiscard]] bool operator==(const iterator& other) const noexcept {
+        return first_ == other.first_;
+      }
+    };
+
+    ByteSplitView(std::string_view buffer, const ByteClass& delimiters, byte_scan_isa isa) :
+        buffer_(buffer), delimiters_(delimiters), isa_(isa) {
+    }
+
+    [[nodiscard]] iterator begin() const {
+      return iterator(this, buffer_.empty() ? std::string_view::npos : 0);
+    }
+
+    [[nodiscard]] iterator end() const {
+      return iterator(this, std::string_view::npos);
+    }
+  };
+
+  /***
+   * split_by
+   *
+   * Return a lazy range over the tokens of buffer separated by the bytes of delimiters. The
+   * buffer is classified by match_mask a block of 64 bytes at a time, and the delimiters are
+   * then popped from the block mask, so dense delimiters don't cost a scan each.
+   * Time: O(n) for a whole iteration, Space: O(1)
+   */
+  [[nodiscard]] inline ByteSplitView split_by(std::string_view buffer,
+                                              const ByteClass& delimiters,
+                                              byte_scan_isa isa = best_byte_scan_isa()) {
+    return ByteSplitView(buffer, delimiters, isa);
+  }
+}  // namespace jkds::util
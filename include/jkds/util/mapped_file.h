@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JKDS_HAS_MMAP 1
+#else
+#define JKDS_HAS_MMAP 0
+#endif
+
+namespace jkds::util {
+
+#if JKDS_HAS_MMAP
+  /***
+   * MappedFile
+   *
+   * A read-only memory mapping of a whole file, which is unmapped on destruction.
+   * The pages are loaded lazily by the operating system, so files larger than the available
+   * memory can be scanned without copying them into the process' heap.
+   * MappedFile is only available on POSIX systems, where JKDS_HAS_MMAP is defined as 1.
+   *
+   * Public methods:
+   * - data()
+   * - size()
+   * - as<T>()
+   * - advise_sequential()
+   */
+  class MappedFile {
+  private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    void unmap() noexcept {
+      if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+      }
+    }
+
+  public:
+    MappedFile() = delete;
+
+    // map the file at the given path, throwing std::system_error on failure
+    explicit MappedFile(const std::filesystem::path& path) {
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path.string());
+      }
+
+      struct stat info;
+      if (::fstat(fd, &info) != 0) {
+        const auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat " + path.string());
+      }
+
+      // empty files can't be mapped, and are represented by a null pointer
+      size_ = static_cast<std::size_t>(info.st_size);
+      if (size_ > 0) {
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+          const auto error = errno;
+          ::close(fd);
+          throw std::system_error(error, std::generic_category(), "mmap " + path.string());
+        }
+        data_ = static_cast<const std::byte*>(address);
+      }
+
+      // the mapping stays valid after the file descriptor is closed
+      ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept :
+        data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+      if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+      }
+      return *this;
+    }
+
+    ~MappedFile() {
+      unmap();
+    }
+
+    // return the address of the first byte of the file, which is page aligned
+    [[nodiscard]] const std::byte* data() const noexcept {
+      return data_;
+    }
+
+    // return the size of the file in bytes
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    // view the file as an array of trivially copyable T, ignoring any trailing partial T
+    template <typename T>
+    [[nodiscard]] std::span<const T> as() const noexcept {
+      return std::span<const T>(reinterpret_cast<const T*>(data_), size_ / sizeof(T));
+    }
+
+    // hint the operating system that the file will be read sequentially, so that pages are
+    // read ahead aggressively and can be evicted soon after they're read
+    void advise_sequential() const noexcept {
+      if (data_ != nullptr) {
+        ::madvise(const_cast<std::byte*>(data_), size_, MADV_SEQUENTIAL);
+      }
+    }
+  };
+#endif
+}  // namespace jkds::util
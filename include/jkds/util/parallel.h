@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jkds::util {
+
+  /***
+   * default_num_threads
+   *
+   * Return the number of concurrent threads supported by the hardware, or 1 if it's unknown.
+   */
+  [[nodiscard]] inline std::size_t default_num_threads() noexcept {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  /***
+   * parallel_invoke
+   *
+   * Invoke f(t) for every thread index t in [0, num_threads), each on its own thread, and wait
+   * for all of them to complete. f(0) runs on the calling thread.
+   * If any f(t) throws, the first exception is rethrown on the calling thread once every
+   * thread has completed. If a thread can't be created, the threads started so far are joined,
+   * and std::system_error is rethrown before f(0) runs.
+   */
+  template <typename F>
+  void parallel_invoke(std::size_t num_threads, F&& f) {
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    // run f(t), keeping the first exception thrown by any thread
+    auto run = [&](std::size_t t) noexcept {
+      try {
+        f(t);
+      } catch (...) {
+        const std::lock_guard lock{error_mutex};
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    auto join_all = [&threads]() noexcept {
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    };
+
+    try {
+      threads.reserve(num_threads > 0 ? num_threads - 1 : 0);
+      for (std::size_t t = 1; t < num_threads; ++t) {
+        threads.emplace_back(run, t);
+      }
+    } catch (...) {
+      // destroying a joinable thread would call std::terminate
+      join_all();
+      throw;
+    }
+
+    run(std::size_t(0));
+    join_all();
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  /***
+   * parallel_for
+   *
+   * Split [first, last) into at most num_threads contiguous chunks of the same size, and invoke
+   * f(chunk_first, chunk_last) for every chunk, each on its own thread.
+   * Exceptions are handled as in parallel_invoke.
+   */
+  template <typename F>
+  void parallel_for(std::size_t first, std::size_t last, F&& f,
+                    std::size_t num_threads = default_num_threads()) {
+    const auto size = last > first ? last - first : 0;
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, size));
+    const auto chunk = (size + num_threads - 1) / num_threads;
+
+    parallel_invoke(num_threads, [&](std::size_t t) {
+      const auto chunk_first = first + std::min(size, t * chunk);
+      const auto chunk_last = first + std::min(size, (t + 1) * chunk);
+
+      if (chunk_first < chunk_last) {
+        f(chunk_first, chunk_last);
+      }
+    });
+  }
+}  // namespace jkds::util
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace jkds::util {
+
+  /***
+   * prefetch
+   *
+   * Hint the processor to load the cache line containing the given address, expecting it to
+   * be read (or written, if for_write is true) soon. It's a no-op on compilers without
+   * __builtin_prefetch, and it never faults, even on invalid addresses.
+   */
+  template <bool for_write = false>
+  inline void prefetch([[maybe_unused]] const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, for_write ? 1 : 0, 3);
+#endif
+  }
+}  // namespace jkds::util
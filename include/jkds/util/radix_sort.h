@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.h"
+
+namespace jkds::util {
+
+  /***
+   * radix_key
+   *
+   * Map an arithmetic value to an unsigned integer of the same size, such that the order of the
+   * unsigned integers matches the order of the original values.
+   * Signed integers have their sign bit flipped. IEEE-754 floating point numbers have their sign
+   * bit flipped if they're positive, and every bit flipped if they're negative: -0.0 is ordered
+   * right before +0.0, and NaNs are ordered after +infinity, or before -infinity if their sign
+   * bit is set.
+   */
+  template <typename T>
+  requires std::is_arithmetic_v<T>
+  [[nodiscard]] constexpr auto radix_key(T value) noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+      using key_t = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+      static_assert(sizeof(T) == sizeof(key_t), "only float and double are supported");
+      constexpr auto sign = key_t(1) << (8 * sizeof(key_t) - 1);
+
+      const auto bits = std::bit_cast<key_t>(value);
+      return (bits & sign) ? key_t(~bits) : key_t(bits | sign);
+    } else if constexpr (std::is_signed_v<T>) {
+      using key_t = std::make_unsigned_t<T>;
+      constexpr auto sign = key_t(1) << (8 * sizeof(key_t) - 1);
+      return key_t(key_t(value) ^ sign);
+    } else {
+      return value;
+    }
+  }
+
+  /***
+   * radix_sort
+   *
+   * Stable sort of the given items by the unsigned integer key(item), using a least significant
+   * digit radix sort with 8-bit digits. The passes over digits shared by every item are skipped.
+   * Every pass is split among num_threads threads: each thread builds the histogram of its
+   * contiguous chunk of items, and then scatters its chunk at the offsets reserved for it.
+   * T must be default constructible.
+   * Time: O(n sizeof(key) / num_threads + 256 num_threads), Space: O(n + 256 num_threads)
+   */
+  template <typename T, typename KeyF>
+  requires std::unsigned_integral<std::invoke_result_t<KeyF&, const T&>>
+  void radix_sort(std::vector<T>& items, KeyF key, std::size_t num_threads = 1) {
+    using key_t = std::invoke_result_t<KeyF&, const T&>;
+    constexpr std::size_t radix = 256;
+    using histogram_t = std::array<std::size_t, radix>;
+
+    const auto n = items.size();
+    num_threads = std::max<std::size_t>(1, std::min(num_threads, n / radix + 1));
+    const auto chunk = (n + num_threads - 1) / num_threads;
+
+    std::vector<T> buffer(n);
+    std::vector<histogram_t> histograms(num_threads);
+
+    for (std::size_t shift = 0; shift < 8 * sizeof(key_t); shift += 8) {
+      auto digit = [&](const T& item) {
+        return static_cast<std::size_t>((key(item) >> shift) & (radix - 1));
+      };
+
+      // per-thread histograms of the current digit
+      parallel_invoke(num_threads, [&](std::size_t t) {
+        auto& histogram = histograms[t];
+        histogram.fill(0);
+        for (auto k = t * chunk; k < std::min(n, (t + 1) * chunk); ++k) {
+          ++histogram[digit(items[k])];
+        }
+      });
+
+      // skip the pass if every item has the same digit
+      std::size_t total = 0;
+      bool trivial = false;
+      for (std::size_t d = 0; d < radix && !trivial; ++d) {
+        std::size_t count = 0;
+        for (auto& histogram : histograms) {
+          count += histogram[d];
+        }
+        trivial = count == n;
+      }
+      if (trivial) {
+        continue;
+      }
+
+      // exclusive prefix sums, ordered by digit first and thread second, to keep stability
+      for (std::size_t d = 0; d < radix; ++d) {
+        for (auto& histogram : histograms) {
+          const auto count = histogram[d];
+          histogram[d] = total;
+          total += count;
+        }
+      }
+
+      parallel_invoke(num_threads, [&](std::size_t t) {
+        auto& offsets = histograms[t];
+        for (auto k = t * chunk; k < std::min(n, (t + 1) * chunk); ++k) {
+          buffer[offsets[digit(items[k])]++] = std::move(items[k]);
+        }
+      });
+
+      items.swap(buffer);
+    }
+  }
+}  // namespace jkds::util
@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <jkds/container/aggregate_disjoint_set.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class AggregateDisjointSetTest : public ::testing::Test {};
+
+  // per-cluster analytics: total weight, earliest timestamp and number of members
+  struct ClusterStats {
+    double weight;
+    int64_t first_seen;
+    size_t count;
+  };
+
+  struct CombineStats {
+    ClusterStats operator()(const ClusterStats& a, const ClusterStats& b) const {
+      return {a.weight + b.weight, std::min(a.first_seen, b.first_seen), a.count + b.count};
+    }
+  };
+
+  // an aggregate whose move throws if it was built to fail
+  struct Fragile {
+    int value;
+    bool fail = false;
+
+    Fragile(int value, bool fail = false) : value(value), fail(fail) {
+    }
+
+    Fragile(const Fragile&) = default;
+
+    Fragile(Fragile&& other) : value(other.value), fail(other.fail) {
+      if (fail) {
+        throw std::runtime_error("Fragile");
+      }
+    }
+
+    Fragile& operator=(const Fragile&) = default;
+  };
+
+  struct CombineFragile {
+    Fragile operator()(const Fragile& a, const Fragile& b) const {
+      return {a.value + b.value};
+    }
+  };
+
+}  // namespace
+
+TEST_F(AggregateDisjointSetTest, sum) {
+  AggregateDisjointSet<char, int> ds{{'a', 'b', 'c', 'd'}, {1, 2, 3, 4}};
+
+  EXPECT_EQ(ds.aggregate_of('c'), 3);
+  EXPECT_TRUE(ds.unite('a', 'b'));
+  EXPECT_TRUE(ds.unite('c', 'd'));
+  EXPECT_FALSE(ds.unite('b', 'a'));
+  EXPECT_EQ(ds.aggregate_of('a'), 3);
+  EXPECT_EQ(ds.aggregate_of('d'), 7);
+  EXPECT_EQ(ds.num_sets(), 2);
+
+  ds.accumulate('b', 10);
+  EXPECT_EQ(ds.aggregate_of('a'), 13);
+
+  EXPECT_EQ(ds.add('e', 100), 4);
+  EXPECT_TRUE(ds.unite('e', 'c'));
+  EXPECT_EQ(ds.aggregate_of('d'), 107);
+  EXPECT_EQ(ds.set_size('d'), 3);
+  EXPECT_FALSE(ds.are_connected('a', 'e'));
+}
+
+TEST_F(AggregateDisjointSetTest, stats) {
+  AggregateDisjointSet<string, ClusterStats, CombineStats> ds{
+      {"x", "y", "z"}, {{1.5, 30, 1}, {2.0, 10, 1}, {0.5, 20, 1}}};
+
+  ds.unite("x", "y");
+  ds.unite("z", "x");
+
+  const auto& stats = ds.aggregate_of("y");
+  EXPECT_EQ(stats.weight, 4.0);
+  EXPECT_EQ(stats.first_seen, 10);
+  EXPECT_EQ(stats.count, 3);
+}
+
+TEST_F(AggregateDisjointSetTest, non_commutative) {
+  // string concatenation is associative but not commutative: the order of unite matters
+  AggregateDisjointSet<int, string> ds{{0, 1, 2, 3}, {"a", "b", "c", "d"}};
+
+  ds.unite(0, 1);
+  ds.unite(3, 2);
+  ds.unite(2, 0);
+  EXPECT_EQ(ds.aggregate_of(1), "dcab");
+}
+
+TEST_F(AggregateDisjointSetTest, on_merge) {
+  AggregateDisjointSet<int, int> ds{{0, 1, 2}, {5, 6, 7}};
+  vector<pair<int, int>> merges;
+  auto on_merge = [&](int a, int b) {
+    merges.emplace_back(a, b);
+  };
+
+  EXPECT_TRUE(ds.unite(0, 1, on_merge));
+  EXPECT_FALSE(ds.unite(1, 0, on_merge));
+  EXPECT_TRUE(ds.unite(2, 1, on_merge));
+  EXPECT_EQ(merges, (vector<pair<int, int>>{{5, 6}, {7, 11}}));
+  EXPECT_EQ(ds.aggregate_of(0), 18);
+
+  const auto partition = ds.get_partition();
+  ASSERT_EQ(partition.size(), 1);
+  EXPECT_EQ(partition.group_size(0), 3);
+}
+
+TEST_F(AggregateDisjointSetTest, throwing_combine) {
+  // a combine which rejects the merges whose total would exceed 10
+  auto bounded_sum = [](const int& a, const int& b) {
+    if (a + b > 10) {
+      throw std::overflow_error("bounded_sum");
+    }
+    return a + b;
+  };
+  AggregateDisjointSet<char, int, decltype(bounded_sum)> ds{{'a', 'b', 'c'}, {4, 5, 6},
+                                                            bounded_sum};
+
+  vector<pair<int, int>> merges;
+  auto on_merge = [&](int a, int b) {
+    merges.emplace_back(a, b);
+  };
+  EXPECT_TRUE(ds.unite('a', 'b', on_merge));
+  EXPECT_THROW(ds.unite('c', 'a', on_merge), std::overflow_error);
+
+  // on_merge only saw the merge which happened
+  EXPECT_EQ(merges, (vector<pair<int, int>>{{4, 5}}));
+
+  // the failed unite left everything as it was
+  EXPECT_EQ(ds.aggregate_of('a'), 9);
+  EXPECT_EQ(ds.aggregate_of('b'), 9);
+  EXPECT_EQ(ds.aggregate_of('c'), 6);
+  EXPECT_FALSE(ds.are_connected('a', 'c'));
+  EXPECT_EQ(ds.num_sets(), 2);
+}
+
+TEST_F(AggregateDisjointSetTest, throwing_accumulate) {
+  // a combine which takes the aggregate by value, and rejects the strings longer than 4
+  auto bounded_concat = [](string a, const string& b) {
+    if (a.size() + b.size() > 4) {
+      throw std::length_error("bounded_concat");
+    }
+    return a + b;
+  };
+  AggregateDisjointSet<int, string, decltype(bounded_concat)> ds{{1, 2}, {"ab", "c"},
+                                                                 bounded_concat};
+
+  ds.accumulate(1, "d");
+  EXPECT_EQ(ds.aggregate_of(1), "abd");
+
+  // the failed accumulate left the aggregate as it was
+  EXPECT_THROW(ds.accumulate(1, "ef"), std::length_error);
+  EXPECT_EQ(ds.aggregate_of(1), "abd");
+}
+
+TEST_F(AggregateDisjointSetTest, throwing_add) {
+  AggregateDisjointSet<string, Fragile, CombineFragile> ds{{"a", "b"}, {Fragile{1}, Fragile{2}}};
+
+  // the failed add left no element behind
+  EXPECT_THROW(ds.add("c", Fragile{3, true}), std::runtime_error);
+  EXPECT_EQ(ds.size(), 2);
+  EXPECT_EQ(ds.num_sets(), 2);
+
+  EXPECT_EQ(ds.add("c", Fragile{3}), 2);
+  ds.unite("a", "c");
+  EXPECT_EQ(ds.aggregate_of("c").value, 4);
+  EXPECT_EQ(ds.get_partition().size(), 2);
+}
+
+TEST_F(AggregateDisjointSetTest, invalid_inputs) {
+  // a repeated input would shift the aggregates of the following ones
+  using ds_t = AggregateDisjointSet<char, int>;
+  EXPECT_THROW((ds_t{{'a', 'a', 'b'}, {1, 2, 3}}), std::invalid_argument);
+  EXPECT_THROW((ds_t{{'a', 'b'}, {1, 2, 3}}), std::invalid_argument);
+  EXPECT_THROW((ds_t{{'a', 'b'}, {1}}), std::invalid_argument);
+
+  ds_t ds{{'a', 'b'}, {1, 2}};
+  EXPECT_THROW(ds.add('a', 3), std::invalid_argument);
+  EXPECT_EQ(ds.add('c', 3), 2);
+  ds.unite('b', 'c');
+  EXPECT_EQ(ds.aggregate_of('c'), 5);
+  EXPECT_EQ(ds.aggregate_of('a'), 1);
+}
+
+TEST_F(AggregateDisjointSetTest, copy) {
+  // the elements are stored once, in the index map, so a copy must point to its own keys
+  auto original = std::make_unique<AggregateDisjointSet<string, int>>(
+      vector<string>{"a", "b", "c"}, vector<int>{1, 2, 3});
+  original->unite("a", "c");
+  AggregateDisjointSet<string, int> copy{*original};
+  AggregateDisjointSet<string, int> assigned{{"z"}, {0}};
+  assigned = *original;
+  original.reset();
+
+  for (auto* ds : {&copy, &assigned}) {
+    ds->add("d", 4);
+    EXPECT_EQ(ds->aggregate_of("c"), 4);
+    vector<vector<string>> groups;
+    for (auto group : ds->get_partition()) {
+      groups.emplace_back(group.begin(), group.end());
+    }
+    EXPECT_EQ(groups, (vector<vector<string>>{{"a", "c"}, {"b"}, {"d"}}));
+  }
+}
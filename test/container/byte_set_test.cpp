@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <jkds/container/byte_set.h>
+
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class ByteSetTest : public ::testing::Test {
+  protected:
+    static ByteSet random_set(std::mt19937& rng, size_t tries) {
+      std::uniform_int_distribution<int> dist{0, 255};
+      ByteSet set;
+      for (size_t k = 0; k < tries; ++k) {
+        set.add(static_cast<uint8_t>(dist(rng)));
+      }
+      return set;
+    }
+
+    static std::bitset<256> to_bitset(const ByteSet& set) {
+      std::bitset<256> bits;
+      for (unsigned b = 0; b < 256; ++b) {
+        bits[b] = set.contains(static_cast<uint8_t>(b));
+      }
+      return bits;
+    }
+  };
+
+  // the set algebra is usable in constant expressions
+  constexpr ByteSet digits{"0123456789"};
+  constexpr ByteSet hex_digits = digits | ByteSet{"abcdefABCDEF"};
+  static_assert(hex_digits.size() == 22);
+  static_assert((hex_digits & ByteSet{"9aZ"}) == ByteSet{"9a"});
+  static_assert((hex_digits - digits).size() == 12);
+  static_assert((~digits).size() == 246 && !(~digits).contains('5'));
+  static_assert(hex_digits.rank('a') == 16 && hex_digits.select(16) == 'a');
+  static_assert(*ByteSet{"zA!"}.begin() == '!');
+
+  // tokenizer tables built from string literals and ranges
+  constexpr auto delimiters = make_byte_set("\t\n ,;");
+  static_assert(delimiters.size() == 5 && delimiters.contains(',') && !delimiters.contains('\0'));
+  constexpr auto identifier = make_byte_set("_") | byte_range('a', 'z') | byte_range('A', 'Z');
+  static_assert(identifier.size() == 53 && identifier.contains('q') && !identifier.contains('9'));
+  static_assert(byte_range(0, 255) == ~ByteSet{} && byte_range(0, 0).size() == 1);
+  static_assert(byte_range(60, 200).size() == 141 && byte_range('z', 'a').empty());
+  static_assert(byte_range(63, 64).rank(64) == 1 && byte_range(128, 191).select(63) == 191);
+  static_assert(make_byte_set("") == ByteSet{});
+
+}  // namespace
+
+TEST_F(ByteSetTest, empty) {
+  ByteSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.size(), 0);
+  EXPECT_EQ(set.begin(), set.end());
+  EXPECT_EQ(set.rank(255), 0);
+  EXPECT_THROW(static_cast<void>(set.select(0)), std::out_of_range);
+  for (unsigned b = 0; b < 256; ++b) {
+    EXPECT_FALSE(set.contains(static_cast<uint8_t>(b)));
+  }
+}
+
+TEST_F(ByteSetTest, add_erase) {
+  ByteSet set;
+  EXPECT_TRUE(set.add(0));
+  EXPECT_TRUE(set.add(255));
+  EXPECT_TRUE(set.add(64));
+  EXPECT_FALSE(set.add(64));
+  EXPECT_EQ(set.size(), 3);
+
+  EXPECT_TRUE(set.erase(64));
+  EXPECT_FALSE(set.erase(64));
+  EXPECT_FALSE(set.contains(64));
+  EXPECT_EQ(set.size(), 2);
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST_F(ByteSetTest, from_sparse_byte_set) {
+  SparseByteSet sparse;
+  sparse.add('z');
+  sparse.add('a');
+  sparse.add(200);
+
+  const ByteSet set{sparse};
+  EXPECT_EQ(set, ByteSet{"az\xc8"});
+}
+
+TEST_F(ByteSetTest, ordered_iteration) {
+  std::mt19937 rng{42};
+  for (size_t tries : {1, 10, 100, 1000}) {
+    const auto set = random_set(rng, tries);
+    vector<uint8_t> members(set.begin(), set.end());
+
+    vector<uint8_t> expected;
+    for (unsigned b = 0; b < 256; ++b) {
+      if (set.contains(static_cast<uint8_t>(b))) {
+        expected.push_back(static_cast<uint8_t>(b));
+      }
+    }
+    EXPECT_EQ(members, expected);
+    EXPECT_EQ(set.size(), expected.size());
+  }
+
+  const auto full = ~ByteSet{};
+  EXPECT_EQ(full.size(), 256);
+  EXPECT_EQ(std::distance(full.begin(), full.end()), 256);
+}
+
+TEST_F(ByteSetTest, algebra) {
+  std::mt19937 rng{7};
+  for (size_t k = 0; k < 100; ++k) {
+    const auto a = random_set(rng, 100);
+    const auto b = random_set(rng, 100);
+    const auto bits_a = to_bitset(a);
+    const auto bits_b = to_bitset(b);
+
+    EXPECT_EQ(to_bitset(a | b), bits_a | bits_b);
+    EXPECT_EQ(to_bitset(a & b), bits_a & bits_b);
+    EXPECT_EQ(to_bitset(a - b), bits_a & ~bits_b);
+    EXPECT_EQ(to_bitset(~a), ~bits_a);
+    EXPECT_EQ((a | b).size(), (bits_a | bits_b).count());
+
+    auto c = a;
+    c |= b;
+    c -= b;
+    EXPECT_EQ(c, a - b);
+    c &= a;
+    EXPECT_EQ(c, a - b);
+  }
+}
+
+TEST_F(ByteSetTest, byte_range) {
+  for (unsigned first = 0; first < 256; first += 7) {
+    for (unsigned last = 0; last < 256; last += 5) {
+      const auto set = byte_range(static_cast<uint8_t>(first), static_cast<uint8_t>(last));
+      for (unsigned b = 0; b < 256; ++b) {
+        EXPECT_EQ(set.contains(static_cast<uint8_t>(b)), first <= b && b <= last);
+      }
+    }
+  }
+}
+
+TEST_F(ByteSetTest, rank_select) {
+  std::mt19937 rng{3};
+  for (size_t tries : {1, 30, 300}) {
+    const auto set = random_set(rng, tries);
+    size_t rank = 0;
+    for (unsigned b = 0; b < 256; ++b) {
+      const auto byte = static_cast<uint8_t>(b);
+      EXPECT_EQ(set.rank(byte), rank);
+      if (set.contains(byte)) {
+        EXPECT_EQ(set.select(rank), byte);
+        ++rank;
+      }
+    }
+    EXPECT_THROW(static_cast<void>(set.select(set.size())), std::out_of_range);
+  }
+}
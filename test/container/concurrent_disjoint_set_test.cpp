@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <jkds/container/concurrent_disjoint_set.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class ConcurrentDisjointSetTest : public ::testing::Test {
+  protected:
+    static std::vector<std::pair<std::size_t, std::size_t>> random_edges(std::size_t n,
+                                                                         std::size_t m) {
+      std::mt19937 rng;
+      std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+      std::vector<std::pair<std::size_t, std::size_t>> edges;
+
+      for (std::size_t k = 0; k < m; ++k) {
+        edges.emplace_back(dist(rng), dist(rng));
+      }
+
+      return edges;
+    }
+  };
+
+}  // namespace
+
+TEST_F(ConcurrentDisjointSetTest, sequential) {
+  ConcurrentDisjointSet ds{5};
+  EXPECT_EQ(ds.size(), 5);
+
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(ds.find(i), i);
+  }
+
+  EXPECT_TRUE(ds.unite(0, 1));
+  EXPECT_TRUE(ds.unite(2, 3));
+  EXPECT_FALSE(ds.unite(1, 0));
+  EXPECT_TRUE(ds.are_connected(0, 1));
+  EXPECT_TRUE(ds.are_connected(3, 2));
+  EXPECT_FALSE(ds.are_connected(1, 2));
+  EXPECT_FALSE(ds.are_connected(4, 0));
+
+  EXPECT_TRUE(ds.unite(3, 0));
+  EXPECT_TRUE(ds.are_connected(1, 2));
+  EXPECT_EQ(ds.find(0), ds.find(3));
+  EXPECT_FALSE(ds.are_connected(4, 0));
+}
+
+TEST_F(ConcurrentDisjointSetTest, concurrent_unite) {
+  constexpr std::size_t n = 20000;
+  constexpr std::size_t m = 15000;
+  const auto edges = random_edges(n, m);
+
+  DenseDisjointSet expected{n};
+  std::size_t expected_merges = 0;
+  for (auto&& [u, v] : edges) {
+    expected_merges += expected.unite(u, v);
+  }
+
+  ConcurrentDisjointSet ds{n};
+  std::vector<std::size_t> merges(8, 0);
+  jkds::util::parallel_invoke(merges.size(), [&](std::size_t t) {
+    for (std::size_t k = t; k < edges.size(); k += merges.size()) {
+      merges[t] += ds.unite(edges[k].first, edges[k].second);
+    }
+  });
+
+  std::size_t actual_merges = 0;
+  for (auto merge : merges) {
+    actual_merges += merge;
+  }
+  EXPECT_EQ(actual_merges, expected_merges);
+
+  for (auto&& [u, v] : random_edges(n, m / 2)) {
+    EXPECT_EQ(ds.are_connected(u, v), expected.are_connected(u, v));
+  }
+}
+
+TEST_F(ConcurrentDisjointSetTest, concurrent_chain) {
+  constexpr std::size_t n = 10000;
+  ConcurrentDisjointSet ds{n};
+
+  jkds::util::parallel_for(1, n, [&](std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      ds.unite(i - 1, i);
+      EXPECT_TRUE(ds.are_connected(i, i - 1));
+    }
+  }, 4);
+
+  const auto root = ds.find(0);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(ds.find(i), root);
+  }
+}
@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class DenseDisjointSetTest : public ::testing::Test {
+  };
+
+  std::vector<std::vector<std::size_t>> sorted_sets(DenseDisjointSet& ds) {
+    std::vector<std::vector<std::size_t>> result;
+
+    for (auto [_, set] : ds.get_sets()) {
+      std::sort(set.begin(), set.end());
+      result.push_back(set);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+}  // namespace
+
+TEST_F(DenseDisjointSetTest, empty) {
+  DenseDisjointSet ds{0};
+  EXPECT_EQ(ds.size(), 0);
+  ASSERT_EQ(ds.add(), 0);
+  ASSERT_EQ(ds.add(), 1);
+  ASSERT_EQ(ds.add(), 2);
+  EXPECT_EQ(ds.size(), 3);
+  using sets_t = std::vector<std::vector<std::size_t>>;
+
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0}, {1}, {2}}));
+
+  EXPECT_TRUE(ds.unite(0, 2));
+  EXPECT_FALSE(ds.unite(2, 0));
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0, 2}, {1}}));
+}
+
+TEST_F(DenseDisjointSetTest, full) {
+  DenseDisjointSet ds{5};
+  using sets_t = std::vector<std::vector<std::size_t>>;
+
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0}, {1}, {2}, {3}, {4}}));
+  EXPECT_FALSE(ds.are_connected(0, 1));
+
+  EXPECT_TRUE(ds.unite(0, 1));
+  EXPECT_TRUE(ds.unite(2, 3));
+  EXPECT_TRUE(ds.are_connected(1, 0));
+  EXPECT_FALSE(ds.are_connected(1, 2));
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0, 1}, {2, 3}, {4}}));
+
+  ASSERT_EQ(ds.add(), 5);
+  EXPECT_TRUE(ds.unite(5, 4));
+  EXPECT_TRUE(ds.unite(0, 3));
+  EXPECT_FALSE(ds.unite(1, 2));
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0, 1, 2, 3}, {4, 5}}));
+
+  EXPECT_TRUE(ds.unite(4, 1));
+  EXPECT_EQ(ds.find(0), ds.find(5));
+  ASSERT_EQ(sorted_sets(ds), sets_t({{0, 1, 2, 3, 4, 5}}));
+}
+
+TEST_F(DenseDisjointSetTest, chain) {
+  constexpr std::size_t n = 1000;
+  DenseDisjointSet ds{n};
+
+  for (std::size_t i = 1; i < n; ++i) {
+    EXPECT_TRUE(ds.unite(i - 1, i));
+  }
+
+  const auto root = ds.find(0);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(ds.find(i), root);
+  }
+}
+
+TEST_F(DenseDisjointSetTest, sizes) {
+  DenseDisjointSet ds{6};
+  EXPECT_EQ(ds.num_sets(), 6);
+  EXPECT_EQ(ds.set_size(3), 1);
+
+  ds.unite(0, 1);
+  ds.unite(1, 2);
+  EXPECT_EQ(ds.num_sets(), 4);
+  EXPECT_EQ(ds.set_size(0), 3);
+  EXPECT_EQ(ds.set_size(2), 3);
+  EXPECT_EQ(ds.set_size(3), 1);
+
+  ds.unite(2, 0);
+  EXPECT_EQ(ds.num_sets(), 4);
+  EXPECT_EQ(ds.set_size(1), 3);
+
+  ds.unite(3, 4);
+  ds.unite(4, 1);
+  EXPECT_EQ(ds.num_sets(), 2);
+  EXPECT_EQ(ds.set_size(3), 5);
+  EXPECT_EQ(ds.set_size(5), 1);
+
+  ds.add();
+  EXPECT_EQ(ds.num_sets(), 3);
+  EXPECT_EQ(ds.set_size(6), 1);
+}
+
+TEST_F(DenseDisjointSetTest, get_partition) {
+  DenseDisjointSet ds{7};
+  ds.unite(5, 1);
+  ds.unite(3, 6);
+  ds.unite(6, 0);
+  ds.unite(2, 2);
+
+  for (std::size_t threads : {1, 3}) {
+    const auto partition = ds.get_partition(threads);
+    EXPECT_EQ(partition.size(), ds.num_sets());
+
+    std::vector<std::vector<std::size_t>> groups;
+    for (auto group : partition) {
+      groups.emplace_back(group.begin(), group.end());
+    }
+    EXPECT_EQ(groups, std::vector<std::vector<std::size_t>>({{0, 3, 6}, {1, 5}, {2}, {4}}));
+  }
+
+  const auto doubled = ds.get_partition(1, [](std::size_t i) {
+    return 2 * i;
+  });
+  EXPECT_EQ(std::vector<std::size_t>(doubled[0].begin(), doubled[0].end()),
+            std::vector<std::size_t>({0, 6, 12}));
+}
+
+TEST_F(DenseDisjointSetTest, batch) {
+  const std::size_t n = 5000;
+  std::mt19937 rng;
+  std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+
+  DenseDisjointSet ds{n};
+  for (std::size_t k = 0; k < n / 2; ++k) {
+    ds.unite(dist(rng), dist(rng));
+  }
+  auto expected_ds = ds;
+
+  // more queries than a single block of are_connected_batch
+  std::vector<std::size_t> ids;
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  for (std::size_t k = 0; k < 3000; ++k) {
+    ids.push_back(dist(rng));
+    pairs.emplace_back(dist(rng), k % 7 == 0 ? ids.back() : dist(rng));
+  }
+
+  std::vector<std::size_t> roots(ids.size());
+  ds.find_batch(ids, roots.begin());
+  std::vector<bool> connected(pairs.size());
+  ds.are_connected_batch(pairs, connected.begin());
+
+  for (std::size_t k = 0; k < ids.size(); ++k) {
+    EXPECT_EQ(roots[k], expected_ds.find(ids[k]));
+    EXPECT_EQ(connected[k], expected_ds.are_connected(pairs[k].first, pairs[k].second));
+  }
+
+  // the batches compress paths without changing the sets
+  EXPECT_EQ(ds.num_sets(), expected_ds.num_sets());
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(ds.find(i), expected_ds.find(i));
+  }
+
+  ds.find_batch({}, roots.begin());
+}
+
+TEST_F(DenseDisjointSetTest, members_of) {
+  DenseDisjointSet ds{8};
+  ds.unite(0, 4);
+  ds.unite(6, 2);
+  ds.unite(4, 6);
+  ds.unite(1, 7);
+
+  auto members = [&](std::size_t i) {
+    std::vector<std::size_t> result;
+    std::ranges::copy(ds.members_of(i), std::back_inserter(result));
+    EXPECT_EQ(result.front(), i);
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  EXPECT_EQ(members(2), std::vector<std::size_t>({0, 2, 4, 6}));
+  EXPECT_EQ(members(0), std::vector<std::size_t>({0, 2, 4, 6}));
+  EXPECT_EQ(members(7), std::vector<std::size_t>({1, 7}));
+  EXPECT_EQ(members(3), std::vector<std::size_t>({3}));
+
+  // a redundant unite doesn't break the lists
+  ds.unite(2, 4);
+  EXPECT_EQ(members(4), std::vector<std::size_t>({0, 2, 4, 6}));
+
+  const auto added = ds.add();
+  ds.unite(added, 3);
+  EXPECT_EQ(members(added), std::vector<std::size_t>({3, 8}));
+  EXPECT_EQ(std::ranges::distance(ds.members_of(5)), 1);
+}
+
+TEST_F(DenseDisjointSetTest, compact) {
+  DenseDisjointSet ds{7};
+  ds.unite(5, 1);
+  ds.unite(3, 6);
+  ds.unite(6, 0);
+
+  const auto root_of_0 = ds.find(0);
+  const auto permutation = ds.compact();
+
+  // groups {0, 3, 6}, {1, 5}, {2}, {4}, with the representative first
+  EXPECT_EQ(permutation[root_of_0], 0);
+  EXPECT_EQ(permutation[2], 5);
+  EXPECT_EQ(permutation[4], 6);
+  std::vector<std::size_t> sorted = permutation;
+  std::sort(sorted.begin(), sorted.end());
+  EXPECT_EQ(sorted, std::vector<std::size_t>({0, 1, 2, 3, 4, 5, 6}));
+
+  for (std::size_t i : {0, 3, 6}) {
+    EXPECT_EQ(ds.find(permutation[i]), 0);
+  }
+  for (std::size_t i : {1, 5}) {
+    EXPECT_EQ(ds.find(permutation[i]), 3);
+  }
+  EXPECT_EQ(ds.set_size(1), 3);
+  EXPECT_EQ(ds.set_size(4), 2);
+  EXPECT_EQ(ds.num_sets(), 4);
+
+  std::vector<std::size_t> members;
+  std::ranges::copy(ds.members_of(0), std::back_inserter(members));
+  EXPECT_EQ(members, std::vector<std::size_t>({0, 1, 2}));
+
+  // the structure keeps working after the relabeling
+  ds.unite(6, 1);
+  EXPECT_TRUE(ds.are_connected(permutation[4], permutation[3]));
+  EXPECT_EQ(ds.set_size(0), 4);
+}
+
+TEST_F(DenseDisjointSetTest, add_range) {
+  DenseDisjointSet ds{3};
+  ds.unite(0, 2);
+  ds.reserve(1000);
+
+  const auto indexes = ds.add_range(997, 4);
+  EXPECT_EQ(indexes.front(), 3);
+  EXPECT_EQ(indexes.back(), 999);
+  EXPECT_EQ(ds.size(), 1000);
+  EXPECT_EQ(ds.num_sets(), 999);
+
+  for (auto i : indexes) {
+    EXPECT_EQ(ds.find(i), i);
+    EXPECT_EQ(ds.set_size(i), 1);
+  }
+
+  EXPECT_TRUE(ds.add_range(0).empty());
+  ds.unite(999, 2);
+  EXPECT_EQ(ds.set_size(0), 3);
+  EXPECT_EQ(ds.add(), 1000);
+}
+
+TEST_F(DenseDisjointSetTest, readonly) {
+  constexpr std::size_t n = 1000;
+  DenseDisjointSet ds{n};
+  for (std::size_t i = 0; i + 3 < n; ++i) {
+    ds.unite(i, i + 3);
+  }
+
+  // the readonly methods are const, and agree with the compressing ones
+  const auto& view = ds;
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(view.find_readonly(i), view.find_readonly(i % 3));
+    EXPECT_EQ(view.are_connected_readonly(i, 1), i % 3 == 1);
+  }
+
+  ds.freeze();
+  EXPECT_EQ(ds.num_sets(), 3);
+
+  // after freeze, every element points to its representative, and is shared by many readers
+  std::vector<std::size_t> mismatches(4, 0);
+  jkds::util::parallel_invoke(mismatches.size(), [&](std::size_t t) {
+    for (std::size_t i = 0; i < n; ++i) {
+      mismatches[t] += view.find_readonly(i) != view.find_readonly(i % 3);
+      mismatches[t] += view.are_connected_readonly(i, t % 3) != (i % 3 == t % 3);
+    }
+  });
+  EXPECT_EQ(mismatches, std::vector<std::size_t>(4, 0));
+
+  ds.unite(0, 1);
+  EXPECT_TRUE(view.are_connected_readonly(999, 997));
+  EXPECT_FALSE(view.are_connected_readonly(999, 998));
+}
@@ -3,6 +3,11 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -87,3 +92,205 @@ TEST_F(DisjointSetTest, full) {
   ds.unite('g', 'd');
   ASSERT_EQ(sorted_sets(ds), sets_t({{'a', 'b', 'c', 'd', 'e', 'f', 'g'}}));
 }
+
+TEST_F(DisjointSetTest, sizes) {
+  DisjointSet<char> ds{{'a', 'b', 'c', 'd'}};
+  EXPECT_EQ(ds.size(), 4);
+  EXPECT_EQ(ds.num_sets(), 4);
+
+  EXPECT_TRUE(ds.unite('a', 'b'));
+  EXPECT_FALSE(ds.unite('b', 'a'));
+  EXPECT_EQ(ds.num_sets(), 3);
+  EXPECT_EQ(ds.set_size('a'), 2);
+  EXPECT_EQ(ds.set_size('c'), 1);
+
+  ds.add('e');
+  EXPECT_EQ(ds.size(), 5);
+  EXPECT_EQ(ds.num_sets(), 4);
+
+  EXPECT_TRUE(ds.unite('e', 'b'));
+  EXPECT_EQ(ds.set_size('a'), 3);
+  EXPECT_EQ(ds.set_size('e'), 3);
+  EXPECT_EQ(ds.num_sets(), 3);
+}
+
+TEST_F(DisjointSetTest, get_partition) {
+  DisjointSet<char> ds{{'e', 'b', 'a', 'd'}};
+  ds.add('c');
+  ds.unite('a', 'c');
+  ds.unite('e', 'd');
+  ds.unite('c', 'd');
+
+  const auto partition = ds.get_partition();
+  EXPECT_EQ(partition.size(), 2);
+
+  std::vector<std::vector<char>> groups;
+  for (auto group : partition) {
+    groups.emplace_back(group.begin(), group.end());
+  }
+  EXPECT_EQ(groups, std::vector<std::vector<char>>({{'e', 'a', 'd', 'c'}, {'b'}}));
+}
+
+TEST_F(DisjointSetTest, are_connected_batch) {
+  DisjointSet<char> ds{{'a', 'b', 'c', 'd', 'e'}};
+  ds.unite('a', 'c');
+  ds.unite('d', 'e');
+
+  const std::vector<std::pair<char, char>> pairs{{'a', 'c'}, {'c', 'd'}, {'e', 'd'}, {'b', 'b'}};
+  std::vector<char> connected(pairs.size());
+  ds.are_connected_batch(pairs, connected.begin());
+  EXPECT_EQ(connected, std::vector<char>({1, 0, 1, 1}));
+}
+
+TEST_F(DisjointSetTest, members_of) {
+  DisjointSet<std::string> ds{{"x", "y", "z", "w"}};
+  ds.unite("x", "z");
+  ds.unite("w", "z");
+
+  std::vector<std::string> members;
+  for (auto&& member : ds.members_of("z")) {
+    members.push_back(member);
+  }
+  EXPECT_EQ(members.front(), "z");
+  std::sort(members.begin(), members.end());
+  EXPECT_EQ(members, std::vector<std::string>({"w", "x", "z"}));
+  EXPECT_EQ(std::ranges::distance(ds.members_of("y")), 1);
+}
+
+TEST_F(DisjointSetTest, copy) {
+  // the elements are stored once, in the index map, so a copy must point to its own keys
+  auto original = std::make_unique<DisjointSet<std::string>>(std::vector<std::string>{"a", "b"});
+  original->unite("a", "b");
+  DisjointSet<std::string> copy{*original};
+  DisjointSet<std::string> assigned{{"z"}};
+  assigned = *original;
+  original.reset();
+
+  for (auto* ds : {&copy, &assigned}) {
+    ds->add("c");
+    std::vector<std::string> members;
+    for (auto&& member : ds->members_of("b")) {
+      members.push_back(member);
+    }
+    std::sort(members.begin(), members.end());
+    EXPECT_EQ(members, std::vector<std::string>({"a", "b"}));
+    EXPECT_EQ(ds->get_partition().size(), 2);
+  }
+}
+
+TEST_F(DisjointSetTest, repeated_inputs) {
+  // a repeated input is added only once, so every view lists it once
+  const std::vector<std::string> inputs{"a", "a", "b"};
+  for (auto ds : {DisjointSet<std::string>{inputs}, DisjointSet<std::string>{{"b", "a", "a"}}}) {
+    EXPECT_EQ(ds.size(), 2);
+    EXPECT_EQ(ds.num_sets(), 2);
+    EXPECT_EQ(ds.add("c"), 2);
+    ds.unite("a", "b");
+    EXPECT_EQ(ds.set_size("b"), 2);
+
+    DisjointSet<std::string> copy{ds};
+    for (auto* d : {&ds, &copy}) {
+      std::vector<std::vector<std::string>> groups;
+      for (auto group : d->get_partition()) {
+        groups.emplace_back(group.begin(), group.end());
+        std::sort(groups.back().begin(), groups.back().end());
+      }
+      std::sort(groups.begin(), groups.end());
+      EXPECT_EQ(groups, std::vector<std::vector<std::string>>({{"a", "b"}, {"c"}}));
+      EXPECT_EQ(sorted_sets(*d), std::vector<std::vector<std::string>>({{"a", "b"}, {"c"}}));
+    }
+  }
+}
+
+TEST_F(DisjointSetTest, compact) {
+  DisjointSet<char> ds{{'e', 'b', 'a', 'd'}};
+  ds.add('c');
+  ds.unite('a', 'c');
+  ds.unite('b', 'd');
+
+  const auto permutation = ds.compact();
+  EXPECT_EQ(permutation.size(), 5);
+  EXPECT_EQ(permutation[0], 0);  // 'e' is a singleton, and it was the first element
+
+  EXPECT_EQ(sorted_sets(ds), std::vector<std::vector<char>>({{'a', 'c'}, {'b', 'd'}, {'e'}}));
+  EXPECT_TRUE(ds.are_connected('c', 'a'));
+  EXPECT_FALSE(ds.are_connected('c', 'b'));
+
+  std::vector<std::vector<char>> groups;
+  for (auto group : ds.get_partition()) {
+    groups.emplace_back(group.begin(), group.end());
+  }
+  EXPECT_EQ(groups, std::vector<std::vector<char>>({{'e'}, {'b', 'd'}, {'a', 'c'}}));
+
+  ds.unite('e', 'd');
+  EXPECT_EQ(ds.set_size('b'), 3);
+}
+
+TEST_F(DisjointSetTest, add_range) {
+  DisjointSet<std::string> ds{{"a", "b"}};
+  ds.reserve(5);
+
+  const std::vector<std::string> inputs{"c", "d", "e"};
+  const auto indexes = ds.add_range(inputs.begin(), inputs.end());
+  EXPECT_EQ(indexes.size(), 3);
+  EXPECT_EQ(indexes.front(), 2);
+  EXPECT_EQ(indexes.back(), 4);
+  EXPECT_EQ(ds.size(), 5);
+  EXPECT_EQ(ds.num_sets(), 5);
+  EXPECT_TRUE(ds.contains("e"));
+
+  ds.unite("a", "e");
+  EXPECT_TRUE(ds.are_connected("e", "a"));
+  EXPECT_FALSE(ds.are_connected("c", "d"));
+
+  // a single pass input range
+  const auto more = ds.add_range(std::counted_iterator(inputs.begin(), 0),
+                                 std::default_sentinel);
+  EXPECT_TRUE(more.empty());
+  EXPECT_EQ(ds.add("f"), 5);
+}
+
+TEST_F(DisjointSetTest, add_range_rollback) {
+  DisjointSet<std::string> ds{{"a", "b"}};
+
+  // a repeated element is rejected, and leaves nothing behind
+  EXPECT_THROW(ds.add("a"), std::invalid_argument);
+  const std::vector<std::string> repeated{"c", "d", "c"};
+  EXPECT_THROW(ds.add_range(repeated.begin(), repeated.end()), std::invalid_argument);
+  const std::vector<std::string> existing{"c", "b"};
+  EXPECT_THROW(ds.add_range(existing.begin(), existing.end()), std::invalid_argument);
+  EXPECT_EQ(ds.size(), 2);
+  EXPECT_FALSE(ds.contains("c"));
+
+  // so does an iterator which throws partway
+  const std::vector<int> ids{3, 4, 5};
+  auto names = ids | std::views::transform([](int id) {
+                 if (id == 5) {
+                   throw std::runtime_error("names");
+                 }
+                 return std::string(1, static_cast<char>('a' + id - 1));
+               });
+  EXPECT_THROW(ds.add_range(names.begin(), names.end()), std::runtime_error);
+  EXPECT_EQ(ds.size(), 2);
+  EXPECT_EQ(ds.num_sets(), 2);
+  EXPECT_FALSE(ds.contains("c"));
+
+  EXPECT_EQ(ds.add_range(repeated.begin(), repeated.begin() + 2).front(), 2);
+  EXPECT_EQ(ds.add("e"), 4);
+  EXPECT_EQ(ds.get_partition().size(), 5);
+}
+
+TEST_F(DisjointSetTest, readonly) {
+  DisjointSet<std::string> ds{{"a", "b", "c", "d"}};
+  ds.unite("a", "b");
+  ds.unite("b", "c");
+  ds.freeze();
+
+  const auto& view = ds;
+  EXPECT_TRUE(view.are_connected_readonly("a", "c"));
+  EXPECT_FALSE(view.are_connected_readonly("d", "c"));
+  EXPECT_THROW((void) view.are_connected_readonly("a", "z"), std::out_of_range);
+
+  ds.unite("d", "a");
+  EXPECT_TRUE(view.are_connected_readonly("c", "d"));
+}
@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/container/mapped_disjoint_set.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  // a trivially copyable key without a default constructor
+  struct Id {
+    explicit Id(uint32_t value) : value(value) {
+    }
+
+    uint32_t value;
+
+    auto operator<=>(const Id&) const = default;
+  };
+
+  // true iff DisjointSet<T>::load is available
+  template <typename T>
+  concept loadable = requires(const filesystem::path& path) { DisjointSet<T>::load(path); };
+
+}  // namespace
+
+template <>
+struct std::hash<Id> {
+  size_t operator()(const Id& id) const noexcept {
+    return std::hash<uint32_t>{}(id.value);
+  }
+};
+
+namespace {
+
+  class MappedDisjointSetTest : public ::testing::Test {
+  protected:
+    const filesystem::path path_ = filesystem::temp_directory_path() / "jkds_disjoint_set_test";
+
+    void TearDown() override {
+      filesystem::remove(path_);
+    }
+
+    // flip a byte of the saved file
+    void corrupt(std::streamoff offset) const {
+      fstream file(path_, ios::binary | ios::in | ios::out);
+      file.seekg(offset);
+      const char byte = static_cast<char>(file.get() ^ 0x5A);
+      file.seekp(offset);
+      file.put(byte);
+    }
+
+    // overwrite the 8-byte word at the given offset of the saved file
+    void overwrite_word(std::streamoff offset, uint64_t word) const {
+      fstream file(path_, ios::binary | ios::in | ios::out);
+      file.seekp(offset);
+      file.write(reinterpret_cast<const char*>(&word), sizeof(word));
+    }
+
+    // read the 8-byte word at the given offset of the saved file
+    [[nodiscard]] uint64_t read_word(std::streamoff offset) const {
+      ifstream file(path_, ios::binary);
+      file.seekg(offset);
+      uint64_t word = 0;
+      file.read(reinterpret_cast<char*>(&word), sizeof(word));
+      return word;
+    }
+  };
+
+}  // namespace
+
+TEST_F(MappedDisjointSetTest, dense) {
+  DenseDisjointSet ds{1000};
+  std::mt19937 rng;
+  std::uniform_int_distribution<size_t> dist{0, 999};
+  for (size_t k = 0; k < 700; ++k) {
+    ds.unite(dist(rng), dist(rng));
+  }
+  ds.save(path_);
+
+  auto loaded = DenseDisjointSet::load(path_);
+  EXPECT_EQ(loaded.size(), ds.size());
+  EXPECT_EQ(loaded.num_sets(), ds.num_sets());
+
+#if JKDS_HAS_MMAP
+  const MappedDenseDisjointSet mapped{path_};
+  EXPECT_EQ(mapped.size(), ds.size());
+  EXPECT_EQ(mapped.num_sets(), ds.num_sets());
+#endif
+
+  for (size_t i = 0; i < ds.size(); ++i) {
+    const auto j = dist(rng);
+    EXPECT_EQ(loaded.are_connected(i, j), ds.are_connected(i, j));
+    EXPECT_EQ(loaded.set_size(i), ds.set_size(i));
+#if JKDS_HAS_MMAP
+    EXPECT_EQ(mapped.are_connected(i, j), ds.are_connected(i, j));
+    EXPECT_EQ(mapped.set_size(i), ds.set_size(i));
+#endif
+  }
+
+  // the loaded disjoint set is fully functional, including the member lists
+  vector<size_t> members;
+  std::ranges::copy(loaded.members_of(0), back_inserter(members));
+  EXPECT_EQ(members.size(), loaded.set_size(0));
+  loaded.unite(0, 999);
+  EXPECT_TRUE(loaded.are_connected(999, 0));
+}
+
+TEST_F(MappedDisjointSetTest, keyed) {
+  DisjointSet<int64_t> ds{{40, -7, 12, 99, 3}};
+  ds.add(1000);
+  ds.unite(-7, 99);
+  ds.unite(12, 1000);
+  ds.unite(1000, 99);
+  ds.save(path_);
+
+  auto loaded = DisjointSet<int64_t>::load(path_);
+  EXPECT_EQ(loaded.size(), 6);
+  EXPECT_EQ(loaded.num_sets(), 3);
+  EXPECT_TRUE(loaded.are_connected(-7, 12));
+  EXPECT_FALSE(loaded.are_connected(40, 3));
+  EXPECT_EQ(loaded.set_size(99), 4);
+
+  // the order of the elements is preserved
+  EXPECT_EQ(loaded.add(5), 6);
+
+#if JKDS_HAS_MMAP
+  const MappedDisjointSet<int64_t> mapped{path_};
+  EXPECT_EQ(mapped.size(), 6);
+  EXPECT_EQ(mapped.num_sets(), 3);
+  EXPECT_TRUE(mapped.contains(1000));
+  EXPECT_FALSE(mapped.contains(5));
+  EXPECT_TRUE(mapped.are_connected(-7, 12));
+  EXPECT_FALSE(mapped.are_connected(40, 3));
+  EXPECT_EQ(mapped.set_size(12), 4);
+  EXPECT_THROW((void) mapped.set_size(5), std::out_of_range);
+
+  // the keys of a different type are rejected
+  EXPECT_THROW(MappedDisjointSet<int32_t>{path_}, std::runtime_error);
+  const MappedDenseDisjointSet dense{path_};
+  EXPECT_EQ(dense.num_sets(), 3);
+#endif
+}
+
+TEST_F(MappedDisjointSetTest, corrupted) {
+  DenseDisjointSet ds{100};
+  ds.unite(1, 2);
+  ds.save(path_);
+
+  // a flipped byte in the nodes is caught by the checksum, unless verification is skipped
+  corrupt(64 + 16 * 50);
+  EXPECT_THROW((void) DenseDisjointSet::load(path_), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDenseDisjointSet{path_}, std::runtime_error);
+  EXPECT_NO_THROW(MappedDenseDisjointSet(path_, false));
+#endif
+
+  // a flipped byte in the magic number is always caught
+  ds.save(path_);
+  corrupt(0);
+  EXPECT_THROW((void) DenseDisjointSet::load(path_, false), std::runtime_error);
+
+  // a truncated file is always caught
+  ds.save(path_);
+  filesystem::resize_file(path_, filesystem::file_size(path_) - 64);
+  EXPECT_THROW((void) DenseDisjointSet::load(path_, false), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDenseDisjointSet(path_, false), std::runtime_error);
+#endif
+}
+
+TEST_F(MappedDisjointSetTest, repeated_inputs) {
+  // a repeated input doesn't leave a node without a key behind, which load would reject
+  DisjointSet<int>{{1, 2, 1}}.save(path_);
+  auto loaded = DisjointSet<int>::load(path_);
+  EXPECT_EQ(loaded.size(), 2);
+  EXPECT_FALSE(loaded.are_connected(1, 2));
+}
+
+TEST_F(MappedDisjointSetTest, wrong_set_size) {
+  DenseDisjointSet ds{4};
+  ds.unite(2, 3);
+  ds.save(path_);
+
+  // the size of a representative must match the number of its members
+  overwrite_word(64 + 8, 100);
+  EXPECT_THROW((void) DenseDisjointSet::load(path_, false), std::runtime_error);
+
+  ds.save(path_);
+  overwrite_word(64 + 16 * 2 + 8, 1);
+  EXPECT_THROW((void) DenseDisjointSet::load(path_, false), std::runtime_error);
+
+  // the sizes of the other nodes are never read
+  ds.save(path_);
+  overwrite_word(64 + 16 * 3 + 8, 100);
+  EXPECT_EQ(DenseDisjointSet::load(path_, false).get_partition().size(), 3);
+}
+
+TEST_F(MappedDisjointSetTest, oversized_header) {
+  DenseDisjointSet ds{100};
+  ds.save(path_);
+
+  // size * 16 wraps around to the size of the 100 nodes, which must not pass as a valid file
+  overwrite_word(16, 100 + (uint64_t(1) << 60));
+  EXPECT_THROW((void) DenseDisjointSet::load(path_, false), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDenseDisjointSet(path_, false), std::runtime_error);
+#endif
+
+  vector<uint32_t> keys(100);
+  iota(keys.begin(), keys.end(), 0);
+  DisjointSet<uint32_t> keyed{keys};
+  keyed.save(path_);
+
+  // size * key_size wraps around too
+  overwrite_word(16, 100 + (uint64_t(1) << 62));
+  EXPECT_THROW((void) DisjointSet<uint32_t>::load(path_, false), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDisjointSet<uint32_t>(path_, false), std::runtime_error);
+#endif
+
+  // an offset past the end of the file
+  keyed.save(path_);
+  overwrite_word(40, ~uint64_t(0) - 8);
+  EXPECT_THROW((void) DisjointSet<uint32_t>::load(path_, false), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDisjointSet<uint32_t>(path_, false), std::runtime_error);
+#endif
+}
+
+TEST_F(MappedDisjointSetTest, out_of_range) {
+  vector<uint64_t> keys(100);
+  iota(keys.begin(), keys.end(), 0);
+  DisjointSet<uint64_t> ds{keys};
+  ds.unite(3, 4);
+
+  // a misaligned section is always caught
+  ds.save(path_);
+  const auto keys_offset = static_cast<std::streamoff>(read_word(40));
+  const auto indexes_offset = static_cast<std::streamoff>(read_word(48));
+  overwrite_word(40, keys_offset + 8);
+  EXPECT_THROW((void) DisjointSet<uint64_t>::load(path_, false), std::runtime_error);
+#if JKDS_HAS_MMAP
+  EXPECT_THROW(MappedDisjointSet<uint64_t>(path_, false), std::runtime_error);
+
+  // a parent or an index out of range is caught by the queries that read it
+  ds.save(path_);
+  overwrite_word(64 + 16 * 7, 1000);
+  overwrite_word(indexes_offset + 8 * 9, 1000);
+  const MappedDisjointSet<uint64_t> mapped{path_, false};
+  EXPECT_TRUE(mapped.are_connected(3, 4));
+  EXPECT_THROW((void) mapped.set_size(7), std::runtime_error);
+  EXPECT_THROW((void) mapped.contains(9), std::runtime_error);
+
+  const MappedDenseDisjointSet dense{path_, false};
+  EXPECT_THROW((void) dense.find(7), std::runtime_error);
+  EXPECT_THROW((void) dense.find(100), std::out_of_range);
+#endif
+}
+
+TEST_F(MappedDisjointSetTest, repeated_keys) {
+  vector<uint64_t> keys(100);
+  iota(keys.begin(), keys.end(), 0);
+  DisjointSet<uint64_t> ds{keys};
+  ds.unite(3, 4);
+
+  // a repeated index would leave a node without a key
+  ds.save(path_);
+  const auto keys_offset = static_cast<std::streamoff>(read_word(40));
+  const auto indexes_offset = static_cast<std::streamoff>(read_word(48));
+  overwrite_word(indexes_offset + 8, read_word(indexes_offset));
+  EXPECT_THROW((void) DisjointSet<uint64_t>::load(path_, false), std::runtime_error);
+
+  // a repeated key would map two nodes to the same element
+  ds.save(path_);
+  overwrite_word(keys_offset + 8, read_word(keys_offset));
+  EXPECT_THROW((void) DisjointSet<uint64_t>::load(path_, false), std::runtime_error);
+
+  ds.save(path_);
+  EXPECT_TRUE(DisjointSet<uint64_t>::load(path_, false).are_connected(4, 3));
+}
+
+TEST_F(MappedDisjointSetTest, key_types) {
+  static_assert(loadable<Id>);
+  static_assert(!loadable<string>);
+
+  DisjointSet<Id> ds{{Id{5}, Id{3}, Id{9}}};
+  ds.unite(Id{5}, Id{9});
+  ds.save(path_);
+
+  auto loaded = DisjointSet<Id>::load(path_);
+  EXPECT_EQ(loaded.num_sets(), 2);
+  EXPECT_TRUE(loaded.are_connected(Id{9}, Id{5}));
+  EXPECT_FALSE(loaded.contains(Id{4}));
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <jkds/container/partition.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class PartitionTest : public ::testing::Test {
+  };
+
+}  // namespace
+
+TEST_F(PartitionTest, empty) {
+  Partition<int> p;
+  EXPECT_EQ(p.size(), 0);
+  EXPECT_TRUE(p.empty());
+  EXPECT_EQ(p.begin(), p.end());
+  EXPECT_EQ(p.members().size(), 0);
+  EXPECT_EQ(p.offsets().size(), 1);
+}
+
+TEST_F(PartitionTest, groups) {
+  Partition<char> p{{0, 2, 3, 6}, {'a', 'd', 'b', 'c', 'e', 'f'}};
+  EXPECT_EQ(p.size(), 3);
+  EXPECT_FALSE(p.empty());
+  EXPECT_EQ(p.group_size(0), 2);
+  EXPECT_EQ(p.group_size(1), 1);
+  EXPECT_EQ(p.group_size(2), 3);
+  EXPECT_EQ(p[1][0], 'b');
+
+  std::vector<std::vector<char>> groups;
+  for (auto group : p) {
+    groups.emplace_back(group.begin(), group.end());
+  }
+  EXPECT_EQ(groups, std::vector<std::vector<char>>({{'a', 'd'}, {'b'}, {'c', 'e', 'f'}}));
+}
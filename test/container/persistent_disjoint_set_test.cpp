@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/container/persistent_disjoint_set.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class PersistentDisjointSetTest : public ::testing::Test {
+  };
+
+}  // namespace
+
+TEST_F(PersistentDisjointSetTest, empty) {
+  PersistentDisjointSet ds{0};
+  EXPECT_EQ(ds.size(), 0);
+  EXPECT_EQ(ds.num_versions(), 1);
+}
+
+TEST_F(PersistentDisjointSetTest, versions) {
+  PersistentDisjointSet ds{5};
+  EXPECT_EQ(ds.num_versions(), 1);
+
+  const auto v1 = ds.unite(0, 0, 1);
+  const auto v2 = ds.unite(v1, 2, 3);
+  const auto v3 = ds.unite(v2, 1, 3);
+  EXPECT_EQ(ds.num_versions(), 4);
+
+  // a branch off an older version
+  const auto v4 = ds.unite(v1, 4, 0);
+  const auto v5 = ds.unite(v4, 1, 4);
+
+  EXPECT_FALSE(ds.are_connected(0, 0, 1));
+  EXPECT_TRUE(ds.are_connected(v1, 0, 1));
+  EXPECT_FALSE(ds.are_connected(v1, 2, 3));
+  EXPECT_TRUE(ds.are_connected(v2, 2, 3));
+  EXPECT_FALSE(ds.are_connected(v2, 0, 3));
+  EXPECT_TRUE(ds.are_connected(v3, 0, 3));
+  EXPECT_FALSE(ds.are_connected(v3, 4, 0));
+
+  EXPECT_TRUE(ds.are_connected(v4, 4, 1));
+  EXPECT_FALSE(ds.are_connected(v4, 2, 3));
+  EXPECT_EQ(ds.find(v4, 4), ds.find(v5, 4));
+  EXPECT_EQ(ds.num_versions(), 6);
+
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(ds.find(0, i), i);
+  }
+}
+
+TEST_F(PersistentDisjointSetTest, random) {
+  constexpr std::size_t n = 300;
+  std::mt19937 rng;
+  std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  for (std::size_t k = 0; k < n; ++k) {
+    edges.emplace_back(dist(rng), dist(rng));
+  }
+
+  PersistentDisjointSet ds{n};
+  for (std::size_t k = 0; k < edges.size(); ++k) {
+    EXPECT_EQ(ds.unite(k, edges[k].first, edges[k].second), k + 1);
+  }
+
+  // every version matches an ephemeral disjoint set built from the same prefix of edges
+  DenseDisjointSet expected{n};
+  for (std::size_t version = 0; version <= edges.size(); version += 20) {
+    for (std::size_t i = 0; i < n; i += 7) {
+      for (std::size_t j = 0; j < n; j += 11) {
+        EXPECT_EQ(ds.are_connected(version, i, j), expected.are_connected(i, j));
+      }
+    }
+
+    for (std::size_t k = version; k < std::min(version + 20, edges.size()); ++k) {
+      expected.unite(edges[k].first, edges[k].second);
+    }
+  }
+
+  // every unite allocates at most 2 (lg n + 1) nodes
+  EXPECT_LE(ds.num_nodes(), 2 * n - 1 + edges.size() * 2 * (9 + 1));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <jkds/container/rollback_disjoint_set.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class RollbackDisjointSetTest : public ::testing::Test {
+  };
+
+}  // namespace
+
+TEST_F(RollbackDisjointSetTest, unite) {
+  RollbackDisjointSet ds{5};
+  EXPECT_EQ(ds.size(), 5);
+  EXPECT_EQ(ds.num_sets(), 5);
+
+  EXPECT_TRUE(ds.unite(0, 1));
+  EXPECT_TRUE(ds.unite(2, 3));
+  EXPECT_FALSE(ds.unite(1, 0));
+  EXPECT_TRUE(ds.unite(3, 1));
+  EXPECT_EQ(ds.num_sets(), 2);
+  EXPECT_TRUE(ds.are_connected(0, 2));
+  EXPECT_FALSE(ds.are_connected(0, 4));
+  EXPECT_EQ(ds.snapshot(), 3);
+}
+
+TEST_F(RollbackDisjointSetTest, rollback) {
+  RollbackDisjointSet ds{6};
+  ds.unite(0, 1);
+  const auto first = ds.snapshot();
+
+  ds.unite(2, 3);
+  ds.unite(1, 2);
+  const auto second = ds.snapshot();
+
+  ds.unite(4, 5);
+  ds.unite(5, 0);
+  EXPECT_EQ(ds.num_sets(), 1);
+
+  ds.rollback(second);
+  EXPECT_EQ(ds.num_sets(), 3);
+  EXPECT_TRUE(ds.are_connected(0, 3));
+  EXPECT_FALSE(ds.are_connected(4, 5));
+  EXPECT_FALSE(ds.are_connected(4, 0));
+
+  ds.rollback(second);
+  EXPECT_EQ(ds.num_sets(), 3);
+
+  ds.rollback(first);
+  EXPECT_EQ(ds.num_sets(), 5);
+  EXPECT_TRUE(ds.are_connected(0, 1));
+  EXPECT_FALSE(ds.are_connected(1, 2));
+  EXPECT_FALSE(ds.are_connected(2, 3));
+
+  // the rank restored by the rollback keeps the trees balanced
+  ds.unite(2, 3);
+  ds.unite(3, 1);
+  ds.rollback(0);
+  EXPECT_EQ(ds.num_sets(), 6);
+  for (std::size_t i = 0; i < 6; ++i) {
+    EXPECT_EQ(ds.find(i), i);
+  }
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/container/sharded_disjoint_set.h>
+#include <jkds/util/parallel.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class ShardedDisjointSetTest : public ::testing::Test {};
+
+}  // namespace
+
+TEST_F(ShardedDisjointSetTest, empty) {
+  ShardedDisjointSet<int> ds{4};
+  EXPECT_FALSE(ds.contains(1));
+  EXPECT_THROW((void) ds.component_of(1), std::out_of_range);
+
+  ds.merge(2);
+  EXPECT_EQ(ds.size(), 0);
+  EXPECT_EQ(ds.num_sets(), 0);
+  EXPECT_FALSE(ds.contains(1));
+}
+
+TEST_F(ShardedDisjointSetTest, cross_shard) {
+  ShardedDisjointSet<string> ds{3};
+
+  // a - b in shard 0, b - c in shard 1, c - d in shard 2: one set spanning every shard
+  EXPECT_TRUE(ds.shard(0).unite("a", "b"));
+  EXPECT_TRUE(ds.shard(1).unite("b", "c"));
+  EXPECT_TRUE(ds.shard(2).unite("d", "c"));
+  EXPECT_FALSE(ds.shard(2).unite("c", "d"));
+  ds.shard(1).unite("x", "y");
+  ds.shard(0).add("z");
+  EXPECT_EQ(ds.shard(1).size(), 4);
+
+  ds.merge(2);
+  EXPECT_EQ(ds.size(), 7);
+  EXPECT_EQ(ds.num_sets(), 3);
+  EXPECT_TRUE(ds.are_connected("a", "d"));
+  EXPECT_TRUE(ds.are_connected("y", "x"));
+  EXPECT_FALSE(ds.are_connected("a", "x"));
+  EXPECT_FALSE(ds.are_connected("z", "x"));
+  EXPECT_TRUE(ds.contains("z"));
+  EXPECT_FALSE(ds.contains("w"));
+  EXPECT_THROW((void) ds.component_of("w"), std::out_of_range);
+
+  // uniting more pairs requires another merge
+  ds.shard(0).unite("z", "y");
+  EXPECT_FALSE(ds.are_connected("z", "x"));
+  ds.merge(1);
+  EXPECT_TRUE(ds.are_connected("z", "x"));
+  EXPECT_EQ(ds.num_sets(), 2);
+}
+
+TEST_F(ShardedDisjointSetTest, copy) {
+  // the elements are stored once, in the index map of every shard, so a copy must point to its
+  // own keys
+  auto original = std::make_unique<ShardedDisjointSet<string>>(2);
+  original->shard(0).unite("a", "b");
+  original->shard(1).unite("b", "c");
+  ShardedDisjointSet<string> copy{*original};
+  ShardedDisjointSet<string> assigned{1};
+  assigned = *original;
+  original.reset();
+
+  for (auto* ds : {&copy, &assigned}) {
+    ds->shard(1).add("d");
+    ds->merge(2);
+    EXPECT_EQ(ds->size(), 4);
+    EXPECT_TRUE(ds->are_connected("a", "c"));
+    EXPECT_FALSE(ds->are_connected("a", "d"));
+  }
+}
+
+TEST_F(ShardedDisjointSetTest, parallel) {
+  const size_t num_threads = 4;
+  const size_t n = 2000;
+  const size_t m = 1500;
+
+  // disjoint streams of pairs over the same universe of elements
+  std::mt19937 rng;
+  std::uniform_int_distribution<uint64_t> dist{0, n - 1};
+  vector<vector<pair<uint64_t, uint64_t>>> streams(num_threads);
+  DisjointSet<uint64_t> expected{jkds::util::range<uint64_t>(n)};
+
+  for (auto& stream : streams) {
+    for (size_t k = 0; k < m / num_threads; ++k) {
+      stream.emplace_back(dist(rng), dist(rng));
+      expected.unite(stream.back().first, stream.back().second);
+    }
+  }
+
+  ShardedDisjointSet<uint64_t> ds{num_threads};
+  jkds::util::parallel_invoke(num_threads, [&](size_t t) {
+    for (auto&& [x, y] : streams[t]) {
+      ds.shard(t).unite(x, y);
+    }
+  });
+  ds.merge(num_threads);
+
+  for (uint64_t x = 0; x < n; ++x) {
+    if (!ds.contains(x)) {
+      EXPECT_EQ(expected.set_size(x), 1);
+      continue;
+    }
+    for (uint64_t y = x; y < n; y += 37) {
+      if (ds.contains(y)) {
+        EXPECT_EQ(ds.are_connected(x, y), expected.are_connected(x, y));
+      }
+    }
+  }
+}
@@ -17,6 +17,17 @@ namespace {
     SparseByteSet s;
   };
 
+  // a set built at compile time
+  constexpr SparseByteSet vowels = []() {
+    SparseByteSet set;
+    for (auto c : {'a', 'e', 'i', 'o', 'u', 'a'}) {
+      set.add(static_cast<uint8_t>(c));
+    }
+    return set;
+  }();
+  static_assert(vowels.size() == 5 && vowels.contains('o') && !vowels.contains('z'));
+  static_assert(*vowels.begin() == 'a' && *(vowels.end() - 1) == 'u');
+
 }  // namespace
 
 TEST_F(SparseByteSetTest, empty) {
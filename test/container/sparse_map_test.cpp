@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <jkds/container/sparse_map.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class SparseMapTest : public ::testing::Test {
+  };
+
+  // check that the keys and values of the map are exactly those of expected
+  template <typename Map, typename Expected>
+  void check_equal(const Map& map, const Expected& expected) {
+    ASSERT_EQ(map.size(), expected.size());
+    ASSERT_EQ(map.keys().size(), map.values().size());
+    for (size_t i = 0; i < map.size(); ++i) {
+      const auto it = expected.find(map.keys()[i]);
+      ASSERT_NE(it, expected.end());
+      EXPECT_EQ(map.values()[i], it->second);
+    }
+    for (const auto& [key, value] : expected) {
+      ASSERT_TRUE(map.contains(key));
+      EXPECT_EQ(map.at(key), value);
+    }
+  }
+
+  // a value whose constructors throw while armed is true
+  struct Throwing {
+    static inline bool armed = false;
+    int value = 0;
+
+    Throwing() {
+      if (armed) {
+        throw std::runtime_error("default constructor");
+      }
+    }
+
+    Throwing(int v) : value(v) {
+    }
+
+    Throwing(const Throwing& other) : value(other.value) {
+      if (armed) {
+        throw std::runtime_error("copy constructor");
+      }
+    }
+
+    Throwing& operator=(const Throwing&) = default;
+
+    bool operator==(const Throwing&) const = default;
+  };
+
+}  // namespace
+
+TEST_F(SparseMapTest, empty) {
+  SparseMap<uint32_t, int> map{1000};
+  EXPECT_EQ(map.universe(), 1000);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.allocated_pages(), 0);
+  EXPECT_FALSE(map.contains(0));
+  EXPECT_FALSE(map.contains(5000));
+  EXPECT_EQ(map.find(3), nullptr);
+  EXPECT_THROW(static_cast<void>(map.at(3)), std::out_of_range);
+  EXPECT_FALSE(map.erase(3));
+  EXPECT_TRUE(map.keys().empty());
+}
+
+TEST_F(SparseMapTest, insert_find) {
+  SparseMap<uint32_t, string> map{1000};
+  EXPECT_TRUE(map.insert(42, "a"));
+  EXPECT_TRUE(map.insert(7, "b"));
+  EXPECT_FALSE(map.insert(42, "c"));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at(42), "a");
+  EXPECT_EQ(*map.find(7), "b");
+
+  map[999] += "z";
+  map[7] += "b";
+  EXPECT_EQ(map.at(999), "z");
+  EXPECT_EQ(map.at(7), "bb");
+
+  // the dense arrays are in insertion order
+  EXPECT_EQ(vector<uint32_t>(map.keys().begin(), map.keys().end()),
+            (vector<uint32_t>{42, 7, 999}));
+  EXPECT_EQ(map.values()[2], "z");
+
+  EXPECT_THROW(map.insert(1000, "x"), std::out_of_range);
+  EXPECT_THROW(map[1000], std::out_of_range);
+}
+
+TEST_F(SparseMapTest, erase_swaps_with_last) {
+  SparseMap<uint16_t, int> map{100};
+  for (uint16_t k = 0; k < 5; ++k) {
+    map.insert(static_cast<uint16_t>(10 * k), k);
+  }
+
+  EXPECT_TRUE(map.erase(10));
+  EXPECT_FALSE(map.erase(10));
+  EXPECT_FALSE(map.contains(10));
+  EXPECT_EQ(vector<uint16_t>(map.keys().begin(), map.keys().end()),
+            (vector<uint16_t>{0, 40, 20, 30}));
+  EXPECT_EQ(vector<int>(map.values().begin(), map.values().end()), (vector<int>{0, 4, 2, 3}));
+  EXPECT_EQ(map.at(40), 4);
+
+  // erasing the last entry
+  EXPECT_TRUE(map.erase(30));
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.at(20), 2);
+}
+
+TEST_F(SparseMapTest, pages) {
+  SparseMap<uint32_t, int, 64> map{1 << 20};
+  map.insert(0, 1);
+  map.insert(63, 2);
+  EXPECT_EQ(map.allocated_pages(), 1);
+  map.insert(64, 3);
+  map.insert((1 << 20) - 1, 4);
+  EXPECT_EQ(map.allocated_pages(), 3);
+
+  // lookups never allocate
+  EXPECT_FALSE(map.contains(5000));
+  EXPECT_EQ(map.allocated_pages(), 3);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(63));
+  EXPECT_EQ(map.allocated_pages(), 3);
+  EXPECT_TRUE(map.insert(63, 5));
+  EXPECT_EQ(map.at(63), 5);
+}
+
+TEST_F(SparseMapTest, universe_too_large) {
+  EXPECT_THROW((SparseMap<uint8_t, int>{256}), std::invalid_argument);
+  SparseMap<uint8_t, int> map{255};
+  EXPECT_TRUE(map.insert(254, 1));
+}
+
+TEST_F(SparseMapTest, move_only_values) {
+  SparseMap<uint32_t, unique_ptr<int>> map{100};
+  map.insert(1, make_unique<int>(1));
+  map.insert(2, make_unique<int>(2));
+  map.insert(3, make_unique<int>(3));
+  map.erase(1);
+  EXPECT_EQ(*map.at(3), 3);
+  EXPECT_EQ(*map.values()[0], 3);
+}
+
+TEST_F(SparseMapTest, throwing_values) {
+  SparseMap<uint32_t, Throwing> map{100};
+  map.insert(1, Throwing{1});
+  map.insert(2, Throwing{2});
+
+  // the keys and the values stay parallel when a value can't be inserted
+  Throwing::armed = true;
+  EXPECT_THROW(map.insert(3, Throwing{3}), std::runtime_error);
+  EXPECT_THROW(map[4], std::runtime_error);
+  Throwing::armed = false;
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_FALSE(map.contains(4));
+  check_equal(map, std::map<uint32_t, Throwing>{{1, 1}, {2, 2}});
+
+  EXPECT_TRUE(map.erase(1));
+  map[4].value = 4;
+  check_equal(map, std::map<uint32_t, Throwing>{{2, 2}, {4, 4}});
+}
+
+TEST_F(SparseMapTest, random) {
+  mt19937_64 rng{42};
+  uniform_int_distribution<uint32_t> key{0, 9999};
+  uniform_int_distribution<int> operation{0, 99};
+  SparseMap<uint32_t, uint64_t, 256> map{10000};
+  std::map<uint32_t, uint64_t> expected;
+
+  for (size_t k = 0; k < 100000; ++k) {
+    const auto x = key(rng);
+    const auto op = operation(rng);
+    if (op < 50) {
+      EXPECT_EQ(map.insert(x, k), expected.emplace(x, k).second);
+    } else if (op < 60) {
+      map[x] += k;
+      expected[x] += k;
+    } else if (op < 99) {
+      EXPECT_EQ(map.erase(x), expected.erase(x) == 1);
+    } else {
+      map.clear();
+      expected.clear();
+    }
+  }
+  check_equal(map, expected);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <jkds/container/sparse_set.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class SparseSetTest : public ::testing::Test {
+  };
+
+  static_assert(is_same_v<SparseSet<256>::value_type, uint8_t>);
+  static_assert(is_same_v<SparseSet<257>::value_type, uint16_t>);
+  static_assert(is_same_v<SparseSet<65536>::value_type, uint16_t>);
+  static_assert(is_same_v<SparseSet<65537>::value_type, uint32_t>);
+  static_assert(is_same_v<SparseSet<>::value_type, uint32_t>);
+  static_assert(is_same_v<SparseSet<100, uint64_t>::value_type, uint64_t>);
+  static_assert(sizeof(SparseSet<256>) == sizeof(size_t) + 2 * 256);
+
+  // apply the same random operations to the set and to a std::set
+  template <typename Set>
+  void check_random(Set& s, size_t universe, uint64_t seed) {
+    mt19937_64 rng{seed};
+    uniform_int_distribution<size_t> element{0, universe - 1};
+    uniform_int_distribution<int> operation{0, 99};
+    std::set<size_t> expected;
+
+    for (size_t k = 0; k < 20 * universe; ++k) {
+      const auto x = static_cast<typename Set::value_type>(element(rng));
+      const auto op = operation(rng);
+
+      if (op < 50) {
+        EXPECT_EQ(s.add(x), expected.insert(x).second);
+      } else if (op < 90) {
+        EXPECT_EQ(s.erase(x), expected.erase(x) == 1);
+      } else if (op < 99) {
+        EXPECT_EQ(s.contains(x), expected.contains(x));
+      } else {
+        s.clear();
+        expected.clear();
+      }
+
+      EXPECT_EQ(s.size(), expected.size());
+    }
+
+    std::vector<size_t> members(s.begin(), s.end());
+    std::sort(members.begin(), members.end());
+    EXPECT_EQ(members, std::vector<size_t>(expected.begin(), expected.end()));
+  }
+
+}  // namespace
+
+TEST_F(SparseSetTest, basic) {
+  SparseSet<10> s;
+  EXPECT_EQ(s.universe(), 10);
+  EXPECT_TRUE(s.empty());
+
+  EXPECT_TRUE(s.add(3));
+  EXPECT_TRUE(s.add(7));
+  EXPECT_TRUE(s.add(1));
+  EXPECT_FALSE(s.add(7));
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_EQ(std::vector<uint8_t>(s.begin(), s.end()), std::vector<uint8_t>({3, 7, 1}));
+
+  // the last member takes the place of the erased one
+  EXPECT_TRUE(s.erase(3));
+  EXPECT_FALSE(s.erase(3));
+  EXPECT_FALSE(s.contains(3));
+  EXPECT_EQ(std::vector<uint8_t>(s.begin(), s.end()), std::vector<uint8_t>({1, 7}));
+
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  for (uint8_t x = 0; x < 10; ++x) {
+    EXPECT_FALSE(s.contains(x));
+  }
+  EXPECT_TRUE(s.add(7));
+  EXPECT_TRUE(s.contains(7));
+  EXPECT_FALSE(s.contains(1));
+}
+
+TEST_F(SparseSetTest, full) {
+  SparseSet<256> s;
+  for (size_t round = 0; round < 3; ++round) {
+    for (size_t x = 0; x < 256; ++x) {
+      EXPECT_TRUE(s.add(static_cast<uint8_t>(255 - x)));
+    }
+    EXPECT_EQ(s.size(), 256);
+    s.clear();
+  }
+}
+
+TEST_F(SparseSetTest, random) {
+  SparseSet<300> fixed;
+  check_random(fixed, 300, 1);
+
+  SparseSet<> dynamic{5000};
+  EXPECT_EQ(dynamic.universe(), 5000);
+  check_random(dynamic, 5000, 2);
+
+  SparseSet<dynamic_universe, uint16_t> narrow{1000};
+  check_random(narrow, 1000, 3);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <jkds/container/weighted_disjoint_set.h>
+#include <jkds/util/range.h>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace jkds::container;
+
+namespace {
+
+  class WeightedDisjointSetTest : public ::testing::Test {
+  };
+
+}  // namespace
+
+TEST_F(WeightedDisjointSetTest, additive) {
+  WeightedDisjointSet<char, int> ds{{'a', 'b', 'c', 'd'}};
+  EXPECT_EQ(ds.size(), 4);
+  EXPECT_EQ(ds.num_sets(), 4);
+  EXPECT_EQ(ds.diff('a', 'a'), 0);
+  EXPECT_EQ(ds.diff('a', 'b'), std::nullopt);
+
+  // a - b = 3, c - b = 5, d - c = -1
+  EXPECT_TRUE(ds.unite('a', 'b', 3));
+  EXPECT_TRUE(ds.unite('c', 'b', 5));
+  EXPECT_TRUE(ds.unite('d', 'c', -1));
+  EXPECT_EQ(ds.num_sets(), 1);
+
+  EXPECT_EQ(ds.diff('a', 'b'), 3);
+  EXPECT_EQ(ds.diff('b', 'a'), -3);
+  EXPECT_EQ(ds.diff('a', 'c'), -2);
+  EXPECT_EQ(ds.diff('d', 'a'), 1);
+  EXPECT_TRUE(ds.are_connected('d', 'b'));
+
+  // consistent and inconsistent redundant constraints
+  EXPECT_TRUE(ds.unite('d', 'b', 4));
+  EXPECT_FALSE(ds.unite('d', 'b', 5));
+  EXPECT_EQ(ds.diff('d', 'b'), 4);
+
+  ds.add('e');
+  EXPECT_EQ(ds.num_sets(), 2);
+  EXPECT_FALSE(ds.are_connected('e', 'a'));
+  EXPECT_TRUE(ds.unite('b', 'e', 10));
+  EXPECT_EQ(ds.diff('a', 'e'), 13);
+}
+
+TEST_F(WeightedDisjointSetTest, xor) {
+  // parity constraints: x ^ y = 1 iff x and y have different colors
+  WeightedDisjointSet<std::string, std::uint8_t, xor_group<std::uint8_t>> ds{
+      {"u", "v", "w", "z"}};
+
+  EXPECT_TRUE(ds.unite("u", "v", 1));
+  EXPECT_TRUE(ds.unite("v", "w", 1));
+  EXPECT_EQ(ds.diff("u", "w"), 0);
+
+  // an odd cycle isn't 2-colorable
+  EXPECT_FALSE(ds.unite("w", "u", 1));
+  EXPECT_TRUE(ds.unite("w", "z", 1));
+  EXPECT_EQ(ds.diff("z", "u"), 1);
+}
+
+TEST_F(WeightedDisjointSetTest, repeated_inputs) {
+  // a repeated input is added only once
+  WeightedDisjointSet<char, int> ds{{'a', 'b', 'a'}};
+  EXPECT_EQ(ds.size(), 2);
+  EXPECT_EQ(ds.num_sets(), 2);
+
+  // and a repeated element is rejected, leaving nothing behind
+  EXPECT_THROW(ds.add('b'), std::invalid_argument);
+  EXPECT_EQ(ds.size(), 2);
+  EXPECT_EQ(ds.add('c'), 2);
+  EXPECT_TRUE(ds.unite('c', 'a', 2));
+  EXPECT_EQ(ds.diff('a', 'c'), -2);
+  EXPECT_EQ(ds.num_sets(), 2);
+}
+
+TEST_F(WeightedDisjointSetTest, random) {
+  // hidden potentials: every constraint built from them is consistent
+  constexpr std::size_t n = 500;
+  std::mt19937 rng;
+  std::uniform_int_distribution<std::size_t> element{0, n - 1};
+  std::uniform_int_distribution<long> value{-1000, 1000};
+
+  std::vector<long> potentials(n);
+  for (auto& p : potentials) {
+    p = value(rng);
+  }
+
+  WeightedDisjointSet<std::size_t, long> ds{jkds::util::range<std::size_t>(n)};
+  for (std::size_t k = 0; k < n; ++k) {
+    const auto x = element(rng), y = element(rng);
+    EXPECT_TRUE(ds.unite(x, y, potentials[x] - potentials[y]));
+  }
+
+  for (std::size_t k = 0; k < n; ++k) {
+    const auto x = element(rng), y = element(rng);
+    const auto d = ds.diff(x, y);
+    EXPECT_EQ(d.has_value(), ds.are_connected(x, y));
+    if (d) {
+      EXPECT_EQ(*d, potentials[x] - potentials[y]);
+      EXPECT_FALSE(ds.unite(x, y, *d + 1));
+    }
+  }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/graph/connected_components.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class ConnectedComponentsTest : public ::testing::Test {
+  protected:
+    static std::vector<edge_t> random_edges(std::size_t n, std::size_t m) {
+      std::mt19937 rng;
+      std::uniform_int_distribution<std::size_t> dist{0, n - 1};
+      std::vector<edge_t> edges;
+
+      for (std::size_t k = 0; k < m; ++k) {
+        edges.emplace_back(dist(rng), dist(rng));
+      }
+
+      return edges;
+    }
+
+    // reference labels: components numbered in increasing order of their smallest vertex
+    static std::vector<std::size_t> expected_labels(const std::vector<edge_t>& edges,
+                                                    std::size_t n) {
+      jkds::container::DenseDisjointSet ds{n};
+      for (auto&& [u, v] : edges) {
+        ds.unite(u, v);
+      }
+
+      std::vector<std::size_t> labels(n), root_labels(n, n);
+      std::size_t next_label = 0;
+      for (std::size_t i = 0; i < n; ++i) {
+        auto& label = root_labels[ds.find(i)];
+        if (label == n) {
+          label = next_label++;
+        }
+        labels[i] = label;
+      }
+
+      return labels;
+    }
+  };
+
+}  // namespace
+
+TEST_F(ConnectedComponentsTest, empty) {
+  EXPECT_EQ(connected_components({}, 0), std::vector<std::size_t>{});
+  EXPECT_EQ(connected_components({}, 3), std::vector<std::size_t>({0, 1, 2}));
+}
+
+TEST_F(ConnectedComponentsTest, small) {
+  const std::vector<edge_t> edges{{4, 3}, {1, 5}, {3, 6}, {5, 1}, {2, 2}};
+  EXPECT_EQ(connected_components(edges, 7, 2), std::vector<std::size_t>({0, 1, 2, 3, 3, 1, 3}));
+}
+
+TEST_F(ConnectedComponentsTest, sparse) {
+  constexpr std::size_t n = 5000;
+  const auto edges = random_edges(n, n / 2);
+  EXPECT_EQ(connected_components(edges, n, 4), expected_labels(edges, n));
+}
+
+TEST_F(ConnectedComponentsTest, dense) {
+  // more than 2n edges, so that the sampling phase is followed by a second phase
+  constexpr std::size_t n = 3000;
+  const auto edges = random_edges(n, 9 * n);
+  EXPECT_EQ(connected_components(edges, n, 4), expected_labels(edges, n));
+  EXPECT_EQ(connected_components(edges, n, 1), expected_labels(edges, n));
+}
+
+TEST_F(ConnectedComponentsTest, unite_batch) {
+  constexpr std::size_t n = 2000;
+  const auto edges = random_edges(n, n);
+
+  jkds::container::ConcurrentDisjointSet ds{n};
+  jkds::container::DenseDisjointSet expected{n};
+  std::size_t expected_merges = 0;
+  for (auto&& [u, v] : edges) {
+    expected_merges += expected.unite(u, v);
+  }
+
+  EXPECT_EQ(ds.unite_batch(edges, 3), expected_merges);
+  EXPECT_EQ(ds.unite_batch(edges, 3), 0);
+
+  ds.compress(2);
+  for (std::size_t i = 0; i < n; ++i) {
+    EXPECT_EQ(ds.are_connected(i, expected.find(i)), true);
+  }
+}
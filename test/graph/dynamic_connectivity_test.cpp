@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/graph/dynamic_connectivity.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class DynamicConnectivityTest : public ::testing::Test {
+  protected:
+    // answer every query by rebuilding a disjoint set from the alive edges
+    static std::vector<bool> naive(std::size_t n, const std::vector<Event>& events) {
+      std::vector<edge_t> alive;
+      std::vector<bool> answers;
+
+      for (auto&& [type, u, v] : events) {
+        const edge_t edge = std::minmax(u, v);
+        if (type == event_type::add_edge) {
+          alive.push_back(edge);
+        } else if (type == event_type::remove_edge) {
+          alive.erase(std::find(alive.begin(), alive.end(), edge));
+        } else {
+          jkds::container::DenseDisjointSet ds{n};
+          for (auto&& [a, b] : alive) {
+            ds.unite(a, b);
+          }
+          answers.push_back(ds.are_connected(u, v));
+        }
+      }
+
+      return answers;
+    }
+  };
+
+}  // namespace
+
+TEST_F(DynamicConnectivityTest, empty) {
+  EXPECT_EQ(offline_dynamic_connectivity(3, {}), std::vector<bool>{});
+
+  const std::vector<Event> events{{event_type::add_edge, 0, 1}};
+  EXPECT_EQ(offline_dynamic_connectivity(3, events), std::vector<bool>{});
+}
+
+TEST_F(DynamicConnectivityTest, small) {
+  const std::vector<Event> events{
+      {event_type::query, 0, 2},       {event_type::add_edge, 0, 1},
+      {event_type::add_edge, 2, 1},    {event_type::query, 0, 2},
+      {event_type::add_edge, 1, 0},    {event_type::remove_edge, 0, 1},
+      {event_type::query, 2, 0},       {event_type::remove_edge, 1, 0},
+      {event_type::query, 0, 2},       {event_type::query, 1, 2},
+      {event_type::query, 3, 3},
+  };
+
+  EXPECT_EQ(offline_dynamic_connectivity(4, events),
+            std::vector<bool>({false, true, true, false, true, true}));
+}
+
+TEST_F(DynamicConnectivityTest, missing_edge) {
+  // the edge (0, 1) was added once, so it can't be removed twice
+  const std::vector<Event> events{
+      {event_type::add_edge, 0, 1},
+      {event_type::remove_edge, 1, 0},
+      {event_type::query, 0, 1},
+      {event_type::remove_edge, 0, 1},
+  };
+  EXPECT_THROW((void) offline_dynamic_connectivity(3, events), std::invalid_argument);
+
+  const std::vector<Event> never_added{{event_type::remove_edge, 0, 2}};
+  EXPECT_THROW((void) offline_dynamic_connectivity(3, never_added), std::invalid_argument);
+}
+
+TEST_F(DynamicConnectivityTest, vertex_out_of_range) {
+  for (auto type : {event_type::add_edge, event_type::remove_edge, event_type::query}) {
+    const std::vector<Event> events{{type, 0, 3}};
+    EXPECT_THROW((void) offline_dynamic_connectivity(3, events), std::invalid_argument);
+  }
+
+  const std::vector<Event> events{{event_type::query, 5, 1}};
+  EXPECT_THROW((void) offline_dynamic_connectivity(3, events), std::invalid_argument);
+}
+
+TEST_F(DynamicConnectivityTest, random) {
+  constexpr std::size_t n = 30;
+  std::mt19937 rng;
+  std::uniform_int_distribution<std::size_t> vertex{0, n - 1};
+  std::uniform_int_distribution<int> action{0, 2};
+
+  std::vector<Event> events;
+  std::vector<edge_t> alive;
+  for (std::size_t k = 0; k < 2000; ++k) {
+    const auto a = action(rng);
+    if (a == 1 && !alive.empty()) {
+      std::uniform_int_distribution<std::size_t> pick{0, alive.size() - 1};
+      const auto it = alive.begin() + pick(rng);
+      events.push_back({event_type::remove_edge, it->second, it->first});
+      alive.erase(it);
+    } else if (a == 0) {
+      const auto u = vertex(rng), v = vertex(rng);
+      events.push_back({event_type::add_edge, u, v});
+      alive.emplace_back(u, v);
+    } else {
+      events.push_back({event_type::query, vertex(rng), vertex(rng)});
+    }
+  }
+
+  EXPECT_EQ(offline_dynamic_connectivity(n, events), naive(n, events));
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <jkds/graph/grid_connected_components.h>
+
+#include <array>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class GridConnectedComponentsTest : public ::testing::Test {
+  };
+
+  // label the mask with a breadth-first search from every unlabeled cell, in memory order
+  GridLabels<uint32_t> bfs_labels(const vector<uint8_t>& mask, ptrdiff_t width, ptrdiff_t height,
+                                  ptrdiff_t depth, grid_connectivity connectivity) {
+    GridLabels<uint32_t> result{vector<uint32_t>(mask.size(), 0), 0};
+    const auto index = [&](ptrdiff_t x, ptrdiff_t y, ptrdiff_t z) {
+      return static_cast<size_t>((z * height + y) * width + x);
+    };
+
+    for (ptrdiff_t z = 0; z < depth; ++z) {
+      for (ptrdiff_t y = 0; y < height; ++y) {
+        for (ptrdiff_t x = 0; x < width; ++x) {
+          if (!mask[index(x, y, z)] || result.labels[index(x, y, z)]) {
+            continue;
+          }
+
+          const auto label = static_cast<uint32_t>(++result.num_components);
+          queue<tuple<ptrdiff_t, ptrdiff_t, ptrdiff_t>> frontier;
+          frontier.emplace(x, y, z);
+          result.labels[index(x, y, z)] = label;
+
+          while (!frontier.empty()) {
+            const auto [cx, cy, cz] = frontier.front();
+            frontier.pop();
+
+            for (ptrdiff_t dz = -1; dz <= 1; ++dz) {
+              for (ptrdiff_t dy = -1; dy <= 1; ++dy) {
+                for (ptrdiff_t dx = -1; dx <= 1; ++dx) {
+                  const auto distance = abs(dx) + abs(dy) + abs(dz);
+                  if (distance == 0 ||
+                      (connectivity == grid_connectivity::face && distance > 1)) {
+                    continue;
+                  }
+
+                  const auto nx = cx + dx, ny = cy + dy, nz = cz + dz;
+                  if (nx < 0 || ny < 0 || nz < 0 || nx >= width || ny >= height || nz >= depth) {
+                    continue;
+                  }
+
+                  const auto n = index(nx, ny, nz);
+                  if (mask[n] && !result.labels[n]) {
+                    result.labels[n] = label;
+                    frontier.emplace(nx, ny, nz);
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    return result;
+  }
+
+  vector<uint8_t> random_mask(size_t size, double density, uint64_t seed) {
+    mt19937_64 rng{seed};
+    bernoulli_distribution foreground{density};
+    uniform_int_distribution<int> value{1, 255};
+    vector<uint8_t> mask(size);
+    for (auto& cell : mask) {
+      cell = foreground(rng) ? static_cast<uint8_t>(value(rng)) : 0;
+    }
+    return mask;
+  }
+
+}  // namespace
+
+TEST_F(GridConnectedComponentsTest, small) {
+  // clang-format off
+  const vector<uint8_t> mask{
+    1, 1, 0, 0, 1,
+    0, 0, 0, 1, 0,
+    1, 0, 1, 1, 0,
+  };
+  // clang-format on
+
+  const auto face = grid_connected_components(mask, 5, 3, grid_connectivity::face);
+  EXPECT_EQ(face.num_components, 4);
+  EXPECT_EQ(face.labels, vector<uint32_t>({1, 1, 0, 0, 2, 0, 0, 0, 3, 0, 4, 0, 3, 3, 0}));
+
+  const auto full = grid_connected_components(mask, 5, 3, grid_connectivity::full);
+  EXPECT_EQ(full.num_components, 3);
+  EXPECT_EQ(full.labels, vector<uint32_t>({1, 1, 0, 0, 2, 0, 0, 0, 2, 0, 3, 0, 2, 2, 0}));
+}
+
+TEST_F(GridConnectedComponentsTest, empty) {
+  EXPECT_EQ(grid_connected_components({}, 0, 0).num_components, 0);
+  EXPECT_EQ(grid_connected_components(vector<uint8_t>(300, 0), 100, 3).num_components, 0);
+
+  const auto full = grid_connected_components(vector<uint8_t>(300, 7), 100, 3);
+  EXPECT_EQ(full.num_components, 1);
+  EXPECT_EQ(full.labels, vector<uint32_t>(300, 1));
+
+  EXPECT_THROW((void) grid_connected_components(vector<uint8_t>(10), 3, 3),
+               std::invalid_argument);
+
+  // 2^16 * 2^24 * 2^24 cells wrap around to the size of an empty mask
+  EXPECT_THROW((void) grid_connected_components({}, size_t(1) << 16, size_t(1) << 24,
+                                                size_t(1) << 24),
+               std::invalid_argument);
+}
+
+TEST_F(GridConnectedComponentsTest, foreground_block) {
+  // the bit i of the SWAR mask, which is the fallback of the targets without SSE2, must be set
+  // iff the byte i is nonzero, whatever its value and position
+  const auto check = [](const vector<uint8_t>& block) {
+    uint64_t expected = 0;
+    for (size_t i = 0; i < 64; ++i) {
+      expected |= uint64_t(block[i] != 0) << i;
+    }
+    EXPECT_EQ(detail::foreground_block_swar(block.data()), expected);
+#if defined(__SSE2__)
+    EXPECT_EQ(detail::foreground_block_sse2(block.data()), expected);
+#endif
+  };
+
+  for (unsigned value = 0; value < 256; ++value) {
+    for (size_t i = 0; i < 64; i += 7) {
+      vector<uint8_t> block(64, 0);
+      block[i] = static_cast<uint8_t>(value);
+      check(block);
+
+      // a single background byte among foreground ones
+      vector<uint8_t> inverted(64, static_cast<uint8_t>(value | 1));
+      inverted[i] = 0;
+      check(inverted);
+    }
+  }
+
+  for (auto density : {0.1, 0.5, 0.9}) {
+    for (size_t seed = 0; seed < 20; ++seed) {
+      check(random_mask(64, density, seed));
+    }
+  }
+}
+
+TEST_F(GridConnectedComponentsTest, random_2d) {
+  for (auto [width, height] : {array<size_t, 2>{1, 50}, {64, 31}, {200, 77}, {333, 9}}) {
+    for (auto density : {0.3, 0.55, 0.8}) {
+      const auto mask = random_mask(width * height, density, width + height);
+
+      for (auto connectivity : {grid_connectivity::face, grid_connectivity::full}) {
+        const auto expected = bfs_labels(mask, width, height, 1, connectivity);
+        for (size_t num_threads : {1, 3, 8}) {
+          const auto actual =
+              grid_connected_components(mask, width, height, connectivity, num_threads);
+          EXPECT_EQ(actual.num_components, expected.num_components);
+          EXPECT_EQ(actual.labels, expected.labels);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(GridConnectedComponentsTest, random_3d) {
+  for (auto [width, height, depth] : {array<size_t, 3>{70, 5, 6}, {13, 17, 11}, {3, 1, 40}}) {
+    for (auto density : {0.2, 0.4}) {
+      const auto mask = random_mask(width * height * depth, density, width * depth);
+
+      for (auto connectivity : {grid_connectivity::face, grid_connectivity::full}) {
+        const auto expected = bfs_labels(mask, width, height, depth, connectivity);
+        for (size_t num_threads : {1, 4, 7}) {
+          const auto actual = grid_connected_components(mask, width, height, depth,
+                                                        connectivity, num_threads);
+          EXPECT_EQ(actual.num_components, expected.num_components);
+          EXPECT_EQ(actual.labels, expected.labels);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(GridConnectedComponentsTest, label_overflow) {
+  // 128 isolated cells don't fit in 7 bits of labels, but they fit in 8
+  vector<uint8_t> mask(256, 0);
+  for (size_t i = 0; i < mask.size(); i += 2) {
+    mask[i] = 1;
+  }
+  EXPECT_EQ(grid_connected_components<uint8_t>(mask, 256, 1).num_components, 128);
+
+  mask.resize(512);
+  for (size_t i = 256; i < mask.size(); i += 2) {
+    mask[i] = 1;
+  }
+  EXPECT_THROW((void) grid_connected_components<uint8_t>(mask, 512, 1), std::out_of_range);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <jkds/container/dense_disjoint_set.h>
+#include <jkds/graph/lowest_common_ancestor.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class LowestCommonAncestorTest : public ::testing::Test {
+  };
+
+  using query_t = pair<size_t, size_t>;
+
+  // climb from both vertices, comparing their sets of ancestors
+  size_t naive_lca(const vector<size_t>& parents, size_t u, size_t v) {
+    vector<uint8_t> ancestors(parents.size(), 0);
+    for (;; u = parents[u]) {
+      ancestors[u] = 1;
+      if (parents[u] == u) {
+        break;
+      }
+    }
+    for (;; v = parents[v]) {
+      if (ancestors[v]) {
+        return v;
+      }
+      if (parents[v] == v) {
+        return no_common_ancestor;
+      }
+    }
+  }
+
+  // a random forest whose vertices are shuffled, so that parents aren't smaller than children
+  vector<size_t> random_forest(size_t n, size_t num_roots, size_t max_jump, uint64_t seed) {
+    mt19937_64 rng{seed};
+    vector<size_t> ids(n);
+    for (size_t i = 0; i < n; ++i) {
+      ids[i] = i;
+    }
+    shuffle(ids.begin(), ids.end(), rng);
+
+    vector<size_t> parents(n);
+    for (size_t i = 0; i < n; ++i) {
+      if (i < num_roots) {
+        parents[ids[i]] = ids[i];
+      } else {
+        const auto jump = uniform_int_distribution<size_t>{1, min(i, max_jump)}(rng);
+        parents[ids[i]] = ids[i - jump];
+      }
+    }
+    return parents;
+  }
+
+  // remove every edge in turn, and check whether its endpoints are still connected
+  vector<size_t> naive_bridges(size_t n, const vector<query_t>& edges) {
+    vector<size_t> result;
+    for (size_t e = 0; e < edges.size(); ++e) {
+      jkds::container::DenseDisjointSet ds{n};
+      for (size_t f = 0; f < edges.size(); ++f) {
+        if (f != e) {
+          ds.unite(edges[f].first, edges[f].second);
+        }
+      }
+      if (!ds.are_connected(edges[e].first, edges[e].second)) {
+        result.push_back(e);
+      }
+    }
+    return result;
+  }
+
+}  // namespace
+
+TEST_F(LowestCommonAncestorTest, small) {
+  // the tree 0 -> {1 -> {3, 4 -> {6}}, 2 -> {5}}, and the singleton tree 7
+  const vector<size_t> parents{0, 0, 0, 1, 1, 2, 4, 7};
+  const vector<query_t> queries{{3, 6}, {6, 3}, {6, 5}, {4, 4}, {1, 6}, {0, 7}, {2, 5}, {7, 7}};
+  const vector<size_t> expected{1, 1, 0, 4, 1, no_common_ancestor, 2, 7};
+
+  EXPECT_EQ(offline_lowest_common_ancestors(parents, queries), expected);
+
+  const LowestCommonAncestor lca{parents};
+  EXPECT_EQ(lca.size(), 8);
+  EXPECT_EQ(lca.depth(6), 3);
+  EXPECT_EQ(lca.depth(7), 0);
+  for (size_t k = 0; k < queries.size(); ++k) {
+    EXPECT_EQ(lca.lca(queries[k].first, queries[k].second), expected[k]);
+  }
+}
+
+TEST_F(LowestCommonAncestorTest, random) {
+  // shallow and bushy trees, deep paths, and forests
+  for (auto [n, num_roots, max_jump] : {tuple<size_t, size_t, size_t>{1000, 1, 1000},
+                                        {3000, 1, 2},
+                                        {500, 7, 30},
+                                        {200, 200, 1}}) {
+    const auto parents = random_forest(n, num_roots, max_jump, n + max_jump);
+
+    mt19937_64 rng{n};
+    uniform_int_distribution<size_t> vertex{0, n - 1};
+    vector<query_t> queries(2000);
+    for (auto& [u, v] : queries) {
+      u = vertex(rng);
+      v = vertex(rng);
+    }
+
+    const auto offline = offline_lowest_common_ancestors(parents, queries);
+    const LowestCommonAncestor lca{parents};
+    for (size_t k = 0; k < queries.size(); ++k) {
+      const auto [u, v] = queries[k];
+      const auto expected = naive_lca(parents, u, v);
+      EXPECT_EQ(offline[k], expected);
+      EXPECT_EQ(lca.lca(u, v), expected);
+    }
+  }
+}
+
+TEST_F(LowestCommonAncestorTest, invalid) {
+  EXPECT_TRUE(offline_lowest_common_ancestors({}, {}).empty());
+
+  const vector<size_t> out_of_range{0, 5};
+  EXPECT_THROW((void) offline_lowest_common_ancestors(out_of_range, {}), std::out_of_range);
+
+  const vector<size_t> cycle{0, 2, 1};
+  EXPECT_THROW(LowestCommonAncestor{cycle}, std::invalid_argument);
+
+  const vector<size_t> parents{0, 0};
+  const vector<query_t> queries{{0, 2}};
+  EXPECT_THROW((void) offline_lowest_common_ancestors(parents, queries), std::out_of_range);
+}
+
+TEST_F(LowestCommonAncestorTest, bridges) {
+  // the cycle 0 - 1 - 2 - 0, hanging 3 - 4 from 2, the parallel edges 4 = 5, the self-loop 6,
+  // and the isolated vertex 7
+  const vector<query_t> edges{{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 4}, {6, 6}};
+  EXPECT_EQ(bridges(8, edges), vector<size_t>({3, 4}));
+
+  EXPECT_TRUE(bridges(0, {}).empty());
+  const vector<query_t> out_of_range{{0, 3}};
+  EXPECT_THROW((void) bridges(3, out_of_range), std::out_of_range);
+
+  // sparse graphs with many bridges, and denser ones with few
+  for (auto [n, m] : {pair<size_t, size_t>{100, 90}, {100, 120}, {300, 400}, {50, 200}}) {
+    mt19937_64 rng{n + m};
+    uniform_int_distribution<size_t> vertex{0, n - 1};
+    vector<query_t> edges(m);
+    for (auto& [u, w] : edges) {
+      u = vertex(rng);
+      w = vertex(rng);
+    }
+    EXPECT_EQ(bridges(n, edges), naive_bridges(n, edges));
+  }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <jkds/container/disjoint_set.h>
+#include <jkds/graph/minimum_spanning_forest.h>
+#include <jkds/util/range.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class MinimumSpanningForestTest : public ::testing::Test {
+  protected:
+    static vector<WeightedEdge<double>> random_edges(size_t n, size_t m) {
+      std::mt19937 rng;
+      std::uniform_int_distribution<size_t> vertex{0, n - 1};
+      std::uniform_int_distribution<int> weight{-50, 50};
+      vector<WeightedEdge<double>> edges;
+
+      for (size_t k = 0; k < m; ++k) {
+        edges.push_back({vertex(rng), vertex(rng), weight(rng) / 4.0});
+      }
+
+      return edges;
+    }
+
+    // reference: Kruskal with std::stable_sort and DisjointSet
+    static vector<WeightedEdge<double>> naive_forest(size_t n,
+                                                     vector<WeightedEdge<double>> edges) {
+      std::stable_sort(edges.begin(), edges.end(),
+                       [](auto&& a, auto&& b) { return a.weight < b.weight; });
+      jkds::container::DisjointSet<size_t> ds{jkds::util::range<size_t>(n)};
+      vector<WeightedEdge<double>> forest;
+
+      for (auto&& edge : edges) {
+        if (ds.unite(edge.u, edge.v)) {
+          forest.push_back(edge);
+        }
+      }
+
+      return forest;
+    }
+
+    static double total_weight(const vector<WeightedEdge<double>>& edges) {
+      double total = 0;
+      for (auto&& edge : edges) {
+        total += edge.weight;
+      }
+      return total;
+    }
+
+    static bool same_edges(const vector<WeightedEdge<double>>& a,
+                           const vector<WeightedEdge<double>>& b) {
+      return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](auto&& x, auto&& y) {
+        return x.u == y.u && x.v == y.v && x.weight == y.weight;
+      });
+    }
+  };
+
+}  // namespace
+
+TEST_F(MinimumSpanningForestTest, empty) {
+  EXPECT_TRUE(minimum_spanning_forest<int>(0, {}).empty());
+  EXPECT_TRUE(minimum_spanning_forest<int>(5, {}, mst_algorithm::boruvka).empty());
+
+  const auto dendrogram = single_linkage<int>(3, {});
+  EXPECT_TRUE(dendrogram.merges.empty());
+  EXPECT_EQ(dendrogram.labels, vector<size_t>({0, 1, 2}));
+}
+
+TEST_F(MinimumSpanningForestTest, small) {
+  // a square with a diagonal, plus an isolated vertex and a self loop
+  const vector<WeightedEdge<int>> edges{
+      {0, 1, 4}, {1, 2, 1}, {2, 3, 3}, {3, 0, 2}, {0, 2, 5}, {4, 4, -1}};
+
+  for (auto algorithm : {mst_algorithm::kruskal, mst_algorithm::boruvka}) {
+    const auto forest = minimum_spanning_forest(5, edges, algorithm, 2);
+    ASSERT_EQ(forest.size(), 3);
+    EXPECT_EQ(forest[0].weight, 1);
+    EXPECT_EQ(forest[1].weight, 2);
+    EXPECT_EQ(forest[2].weight, 3);
+  }
+}
+
+TEST_F(MinimumSpanningForestTest, random) {
+  for (auto [n, m] : {pair<size_t, size_t>{50, 40}, {1000, 5000}, {3000, 2000}}) {
+    const auto edges = random_edges(n, m);
+    const auto expected = naive_forest(n, edges);
+
+    // equal weights are broken by the input order, so the forest is unique
+    EXPECT_TRUE(same_edges(minimum_spanning_forest(n, edges, mst_algorithm::kruskal, 4),
+                           expected));
+    for (size_t threads : {1, 4}) {
+      const auto forest = minimum_spanning_forest(n, edges, mst_algorithm::boruvka, threads);
+      EXPECT_TRUE(same_edges(forest, expected));
+      EXPECT_EQ(total_weight(forest), total_weight(expected));
+    }
+  }
+}
+
+TEST_F(MinimumSpanningForestTest, dendrogram) {
+  // points on a line: 0 - 1 - 2 are close, 3 - 4 are close, 5 is far away
+  const vector<WeightedEdge<float>> edges{
+      {0, 1, 1.0f}, {1, 2, 1.5f}, {3, 4, 0.5f}, {2, 3, 4.0f}, {4, 5, 9.0f}, {0, 2, 2.5f}};
+
+  for (auto algorithm : {mst_algorithm::kruskal, mst_algorithm::boruvka}) {
+    const auto full = single_linkage(6, edges, 1, algorithm);
+    ASSERT_EQ(full.merges.size(), 5);
+
+    EXPECT_EQ(full.merges[0].first + full.merges[0].second, 3 + 4);
+    EXPECT_EQ(full.merges[0].size, 2);
+    EXPECT_EQ(full.merges[1].first + full.merges[1].second, 0 + 1);
+    EXPECT_EQ(full.merges[2].first + full.merges[2].second, 7 + 2);  // cluster 7 is {0, 1}
+    EXPECT_EQ(full.merges[2].size, 3);
+    EXPECT_EQ(full.merges[3].first + full.merges[3].second, 8 + 6);  // {0, 1, 2} with {3, 4}
+    EXPECT_EQ(full.merges[4].first + full.merges[4].second, 9 + 5);
+    EXPECT_EQ(full.merges[4].size, 6);
+    EXPECT_EQ(full.merges[4].edge.weight, 9.0f);
+    EXPECT_EQ(full.labels, vector<size_t>(6, 0));
+
+    const auto three = single_linkage(6, edges, 3, algorithm);
+    EXPECT_EQ(three.merges.size(), 3);
+    EXPECT_EQ(three.labels, vector<size_t>({0, 0, 0, 1, 1, 2}));
+  }
+}
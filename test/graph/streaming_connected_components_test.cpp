@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <jkds/graph/connected_components.h>
+#include <jkds/graph/streaming_connected_components.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace jkds::graph;
+
+namespace {
+
+  class StreamingConnectedComponentsTest : public ::testing::Test {
+  protected:
+    const filesystem::path edges_path_ =
+        filesystem::temp_directory_path() / "jkds_streaming_edges_test";
+    const filesystem::path labels_path_ =
+        filesystem::temp_directory_path() / "jkds_streaming_labels_test";
+
+    void TearDown() override {
+      filesystem::remove(edges_path_);
+      filesystem::remove(labels_path_);
+    }
+
+    template <typename V>
+    void write_edges(const vector<edge_t>& edges) const {
+      ofstream out(edges_path_, ios::binary);
+      for (auto&& [u, v] : edges) {
+        const V ids[2] = {V(u), V(v)};
+        out.write(reinterpret_cast<const char*>(ids), sizeof(ids));
+      }
+    }
+
+    template <typename V>
+    vector<size_t> read_labels() const {
+      ifstream in(labels_path_, ios::binary);
+      vector<size_t> labels;
+      V label;
+      while (in.read(reinterpret_cast<char*>(&label), sizeof(V))) {
+        labels.push_back(label);
+      }
+      return labels;
+    }
+  };
+
+}  // namespace
+
+TEST_F(StreamingConnectedComponentsTest, empty) {
+  write_edges<uint64_t>({});
+  const auto stats = stream_connected_components(edges_path_, 3, labels_path_);
+  EXPECT_EQ(stats.num_edges, 0);
+  EXPECT_EQ(stats.num_components, 3);
+  EXPECT_EQ(read_labels<uint64_t>(), vector<size_t>({0, 1, 2}));
+}
+
+TEST_F(StreamingConnectedComponentsTest, random) {
+  // more edges than fit in a single chunk of 32-bit ids
+  const size_t n = 100000;
+  const size_t m = 700000;
+  std::mt19937 rng;
+  std::uniform_int_distribution<size_t> dist{0, n - 1};
+  vector<edge_t> edges;
+  for (size_t k = 0; k < m; ++k) {
+    edges.emplace_back(dist(rng), dist(rng));
+  }
+
+  const auto expected = connected_components(edges, n, 1);
+  write_edges<uint32_t>(edges);
+
+  for (auto access : {edge_file_access::mapped, edge_file_access::chunked}) {
+    const auto stats =
+        stream_connected_components<uint32_t>(edges_path_, n, labels_path_, access);
+    EXPECT_EQ(stats.num_edges, m);
+    EXPECT_EQ(read_labels<uint32_t>(), expected);
+    EXPECT_EQ(stats.num_components, *max_element(expected.begin(), expected.end()) + 1);
+    EXPECT_GE(stats.edges_per_second(), 0.0);
+  }
+}
+
+TEST_F(StreamingConnectedComponentsTest, errors) {
+  write_edges<uint64_t>({{0, 1}, {2, 5}});
+  for (auto access : {edge_file_access::mapped, edge_file_access::chunked}) {
+    EXPECT_THROW(stream_connected_components(edges_path_, 5, labels_path_, access),
+                 std::out_of_range);
+  }
+
+  {
+    ofstream out(edges_path_, ios::binary | ios::app);
+    out.put('x');
+  }
+  for (auto access : {edge_file_access::mapped, edge_file_access::chunked}) {
+    EXPECT_THROW(stream_connected_components(edges_path_, 6, labels_path_, access),
+                 std::runtime_error);
+  }
+}
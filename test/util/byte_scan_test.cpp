@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <jkds/util/byte_scan.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace jkds::util;
+using jkds::container::ByteSet;
+using jkds::container::SparseByteSet;
+
+namespace {
+
+  class ByteScanTest : public ::testing::Test {
+  protected:
+    // every instruction set supported by the running processor
+    static vector<byte_scan_isa> isas() {
+      vector<byte_scan_isa> result{byte_scan_isa::scalar};
+      if (best_byte_scan_isa() >= byte_scan_isa::ssse3) {
+        result.push_back(byte_scan_isa::ssse3);
+      }
+      if (best_byte_scan_isa() >= byte_scan_isa::avx2) {
+        result.push_back(byte_scan_isa::avx2);
+      }
+      return result;
+    }
+
+    static string random_buffer(size_t size, uint32_t seed) {
+      std::mt19937 rng{seed};
+      std::uniform_int_distribution<int> dist{0, 255};
+      string buffer(size, '\0');
+      for (auto& c : buffer) {
+        c = static_cast<char>(dist(rng));
+      }
+      return buffer;
+    }
+
+    static size_t naive_find(string_view buffer, const ByteClass& byte_class, size_t from) {
+      for (auto i = from; i < buffer.size(); ++i) {
+        if (byte_class.contains(static_cast<uint8_t>(buffer[i]))) {
+          return i;
+        }
+      }
+      return string_view::npos;
+    }
+  };
+
+  // the lookup tables are built at compile time
+  constexpr ByteClass whitespace{string_view{" \t\n"}};
+  static_assert(whitespace.size() == 3 && whitespace.contains('\t') && whitespace.tables().shufti);
+  constexpr ByteClass not_digits{~ByteSet{"0123456789"}};
+  static_assert(not_digits.size() == 246 && not_digits.tables().shufti);
+
+}  // namespace
+
+TEST_F(ByteScanTest, compile_sparse_byte_set) {
+  SparseByteSet set;
+  set.add(' ');
+  set.add('\t');
+  set.add(200);
+
+  ByteClass byte_class{set};
+  EXPECT_EQ(byte_class.size(), 3);
+  EXPECT_TRUE(byte_class.tables().shufti);
+  for (unsigned b = 0; b < 256; ++b) {
+    const auto byte = static_cast<uint8_t>(b);
+    EXPECT_EQ(byte_class.contains(byte), set.contains(byte));
+  }
+}
+
+TEST_F(ByteScanTest, compile_byte_set) {
+  const ByteSet set = ~ByteSet{"abc"};
+  const ByteClass byte_class{set};
+  EXPECT_EQ(byte_class.size(), 253);
+  EXPECT_EQ(find_first_of("abcabcd", byte_class), 6);
+}
+
+TEST_F(ByteScanTest, too_many_buckets) {
+  // 9 distinct sets of low nibbles don't fit in the 8 shufti buckets
+  string bytes;
+  for (int h = 0; h < 9; ++h) {
+    bytes.push_back(static_cast<char>((h << 4) | h));
+  }
+  ByteClass byte_class{bytes};
+  EXPECT_FALSE(byte_class.tables().shufti);
+  EXPECT_EQ(byte_class.size(), 9);
+}
+
+TEST_F(ByteScanTest, empty) {
+  const ByteClass byte_class{string_view{",;"}};
+  for (auto isa : isas()) {
+    EXPECT_EQ(find_first_of("", byte_class, 0, isa), string_view::npos);
+    EXPECT_TRUE(match_bitmap("", byte_class, isa).empty());
+  }
+
+  const ByteClass nothing{string_view{}};
+  const auto buffer = random_buffer(1000, 1);
+  for (auto isa : isas()) {
+    EXPECT_EQ(find_first_of(buffer, nothing, 0, isa), string_view::npos);
+  }
+}
+
+TEST_F(ByteScanTest, find_first_of) {
+  const ByteClass byte_class{string_view{" \t\n,"}};
+  const string buffer = string(100, 'a') + ",b c" + string(70, 'd') + '\n';
+
+  for (auto isa : isas()) {
+    EXPECT_EQ(find_first_of(buffer, byte_class, 0, isa), 100);
+    EXPECT_EQ(find_first_of(buffer, byte_class, 101, isa), 102);
+    EXPECT_EQ(find_first_of(buffer, byte_class, 103, isa), buffer.size() - 1);
+    EXPECT_EQ(find_first_of(buffer, byte_class, buffer.size(), isa), string_view::npos);
+    EXPECT_EQ(find_first_of(string(200, 'x'), byte_class, 0, isa), string_view::npos);
+  }
+}
+
+TEST_F(ByteScanTest, random_classes) {
+  std::mt19937 rng{7};
+  for (size_t members : {1, 3, 8, 16, 40, 128, 255}) {
+    std::uniform_int_distribution<int> dist{0, 255};
+    SparseByteSet set;
+    while (set.size() < members) {
+      set.add(static_cast<uint8_t>(dist(rng)));
+    }
+    const ByteClass byte_class{set};
+    const auto buffer = random_buffer(1000, static_cast<uint32_t>(members));
+
+    for (auto isa : isas()) {
+      for (size_t from : {0, 1, 63, 64, 500, 999}) {
+        EXPECT_EQ(find_first_of(buffer, byte_class, from, isa),
+                  naive_find(buffer, byte_class, from));
+      }
+
+      const auto bitmap = match_bitmap(buffer, byte_class, isa);
+      ASSERT_EQ(bitmap.size(), 16);
+      for (size_t i = 0; i < 16 * 64; ++i) {
+        const auto expected = i < buffer.size() && byte_class.contains(uint8_t(buffer[i]));
+        EXPECT_EQ((bitmap[i / 64] >> (i % 64)) & 1, expected ? 1 : 0);
+      }
+    }
+  }
+}
+
+TEST_F(ByteScanTest, match_mask) {
+  const ByteClass byte_class{string_view{"\n"}};
+  string buffer(100, 'x');
+  buffer[3] = buffer[70] = buffer[99] = '\n';
+
+  for (auto isa : isas()) {
+    EXPECT_EQ(match_mask(buffer, byte_class, 0, isa), uint64_t(1) << 3);
+    EXPECT_EQ(match_mask(buffer, byte_class, 3, isa), 1);
+    EXPECT_EQ(match_mask(buffer, byte_class, 10, isa), uint64_t(1) << 60);
+    EXPECT_EQ(match_mask(buffer, byte_class, 64, isa), (uint64_t(1) << 6) | (uint64_t(1) << 35));
+    EXPECT_EQ(match_mask(buffer, byte_class, 100, isa), 0);
+  }
+}
+
+TEST_F(ByteScanTest, match_bitmap_too_small) {
+  const ByteClass byte_class{string_view{","}};
+  vector<uint64_t> out(1);
+  EXPECT_THROW(match_bitmap(string(65, ','), byte_class, out), std::invalid_argument);
+}
+
+TEST_F(ByteScanTest, split_by) {
+  const ByteClass delimiters{string_view{",;"}};
+  for (auto isa : isas()) {
+    vector<string_view> tokens;
+    for (auto token : split_by("a,bc;;d,", delimiters, isa)) {
+      tokens.push_back(token);
+    }
+    EXPECT_EQ(tokens, (vector<string_view>{"a", "bc", "", "d", ""}));
+
+    EXPECT_EQ(split_by("", delimiters, isa).begin(), split_by("", delimiters, isa).end());
+  }
+
+  // long tokens, across several blocks
+  string buffer;
+  vector<string> expected;
+  for (size_t k = 0; k < 20; ++k) {
+    expected.push_back(string(k * 13, char('a' + k)));
+    buffer += expected.back() + (k % 2 == 0 ? "," : ";");
+  }
+  expected.emplace_back();
+
+  for (auto isa : isas()) {
+    vector<string> tokens;
+    for (auto token : split_by(buffer, delimiters, isa)) {
+      tokens.emplace_back(token);
+    }
+    EXPECT_EQ(tokens, expected);
+  }
+}
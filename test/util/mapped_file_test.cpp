@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <jkds/util/mapped_file.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::util;
+
+#if JKDS_HAS_MMAP
+
+namespace {
+
+  class MappedFileTest : public ::testing::Test {
+  protected:
+    const filesystem::path path_ = filesystem::temp_directory_path() / "jkds_mapped_file_test";
+
+    void TearDown() override {
+      filesystem::remove(path_);
+    }
+  };
+
+}  // namespace
+
+TEST_F(MappedFileTest, read) {
+  const vector<uint32_t> values{1, 2, 3, 0xDEADBEEF};
+  {
+    ofstream out(path_, ios::binary);
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(uint32_t));
+    out.put('x');
+  }
+
+  MappedFile file{path_};
+  EXPECT_EQ(file.size(), values.size() * sizeof(uint32_t) + 1);
+
+  // the trailing partial value is ignored
+  const auto view = file.as<uint32_t>();
+  EXPECT_EQ(vector<uint32_t>(view.begin(), view.end()), values);
+
+  MappedFile moved = std::move(file);
+  EXPECT_EQ(file.data(), nullptr);
+  EXPECT_EQ(moved.as<uint32_t>()[3], 0xDEADBEEF);
+}
+
+TEST_F(MappedFileTest, empty) {
+  ofstream(path_, ios::binary).close();
+  MappedFile file{path_};
+  EXPECT_EQ(file.size(), 0);
+  EXPECT_TRUE(file.as<uint64_t>().empty());
+}
+
+TEST_F(MappedFileTest, missing) {
+  EXPECT_THROW(MappedFile{path_}, std::system_error);
+}
+
+#endif
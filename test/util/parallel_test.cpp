@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <jkds/util/parallel.h>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace jkds::util;
+
+namespace {
+  class ParallelTest : public ::testing::Test {
+  protected:
+    ParallelTest() {}
+  };
+
+}  // namespace
+
+TEST_F(ParallelTest, default_num_threads) {
+  EXPECT_GE(default_num_threads(), 1);
+}
+
+TEST_F(ParallelTest, parallel_invoke) {
+  std::vector<std::size_t> visited(7, 0);
+  parallel_invoke(visited.size(), [&](std::size_t t) {
+    visited[t] = t + 1;
+  });
+  EXPECT_EQ(visited, std::vector<std::size_t>({1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(ParallelTest, parallel_for) {
+  std::vector<std::size_t> visited(103, 0);
+  parallel_for(3, visited.size(), [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; ++i) {
+      ++visited[i];
+    }
+  }, 8);
+
+  for (std::size_t i = 0; i < visited.size(); ++i) {
+    EXPECT_EQ(visited[i], i < 3 ? 0 : 1);
+  }
+}
+
+TEST_F(ParallelTest, parallel_for_more_threads_than_items) {
+  std::atomic<std::size_t> calls = 0;
+  parallel_for(0, 2, [&](std::size_t first, std::size_t last) {
+    EXPECT_EQ(last - first, 1);
+    ++calls;
+  }, 16);
+  EXPECT_EQ(calls, 2);
+
+  parallel_for(5, 5, [&](std::size_t, std::size_t) {
+    ++calls;
+  });
+  EXPECT_EQ(calls, 2);
+}
+
+TEST_F(ParallelTest, exceptions) {
+  // the exception of a worker reaches the caller, once every thread has completed
+  std::atomic<std::size_t> calls = 0;
+  EXPECT_THROW(parallel_invoke(4, [&](std::size_t t) {
+    ++calls;
+    if (t == 2) {
+      throw std::runtime_error("worker");
+    }
+  }), std::runtime_error);
+  EXPECT_EQ(calls, 4);
+
+  EXPECT_THROW(parallel_for(0, 100, [](std::size_t first, std::size_t) {
+    if (first == 0) {
+      throw std::length_error("chunk");
+    }
+  }, 4), std::length_error);
+}
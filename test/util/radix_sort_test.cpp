@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <jkds/util/radix_sort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace jkds::util;
+
+namespace {
+
+  class RadixSortTest : public ::testing::Test {};
+
+}  // namespace
+
+TEST_F(RadixSortTest, radix_key) {
+  EXPECT_LT(radix_key(-5), radix_key(-1));
+  EXPECT_LT(radix_key(-1), radix_key(0));
+  EXPECT_LT(radix_key(0), radix_key(7));
+  EXPECT_LT(radix_key(std::numeric_limits<int64_t>::min()),
+            radix_key(std::numeric_limits<int64_t>::max()));
+  EXPECT_EQ(radix_key(42u), 42u);
+
+  EXPECT_LT(radix_key(-std::numeric_limits<double>::infinity()), radix_key(-1.5));
+  EXPECT_LT(radix_key(-1.5), radix_key(-0.25));
+  EXPECT_LT(radix_key(-0.0f), radix_key(0.0f));
+  EXPECT_LT(radix_key(0.25f), radix_key(1.5f));
+  EXPECT_LT(radix_key(1.5), radix_key(std::numeric_limits<double>::infinity()));
+}
+
+TEST_F(RadixSortTest, empty) {
+  vector<uint32_t> items;
+  radix_sort(items, [](uint32_t x) { return x; }, 4);
+  EXPECT_TRUE(items.empty());
+}
+
+TEST_F(RadixSortTest, integers) {
+  vector<int32_t> items{5, -3, 0, 1000000, -1000000, 7, 7, -3};
+  auto expected = items;
+  std::sort(expected.begin(), expected.end());
+
+  radix_sort(items, [](int32_t x) { return radix_key(x); });
+  EXPECT_EQ(items, expected);
+}
+
+TEST_F(RadixSortTest, stable_parallel) {
+  std::mt19937 rng;
+  std::uniform_int_distribution<int> dist{-100, 100};
+
+  // many duplicate keys, to check stability
+  vector<pair<double, size_t>> items;
+  for (size_t k = 0; k < 100000; ++k) {
+    items.emplace_back(dist(rng) / 8.0, k);
+  }
+
+  auto expected = items;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](auto&& a, auto&& b) { return a.first < b.first; });
+
+  for (size_t threads : {1, 3, 8}) {
+    auto sorted = items;
+    radix_sort(sorted, [](auto&& item) { return radix_key(item.first); }, threads);
+    EXPECT_EQ(sorted, expected);
+  }
+}